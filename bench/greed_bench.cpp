@@ -0,0 +1,408 @@
+/**
+ * @file greed_bench.cpp
+ * @brief Микробенчмарки горячих путей движка и рендерера
+ *
+ * Каждый замер выполняется с фиксированным seed: подготовка пачки операций
+ * (не входит во время) и пачка операций подряд, пока суммарное время не
+ * превысит --min-time-ms. Результаты печатаются в JSON: наносекунды,
+ * выделения памяти и байты выделений на операцию; для рендерера - еще и
+ * байты вывода на кадр. Выделения считает AllocationTracker, который в
+ * этой цели всегда подключен к operator new. Осмысленные цифры дает
+ * только сборка Release.
+ *
+ * Запуск: greed_bench [--filter ПОДСТРОКА] [--min-time-ms N] [--out ФАЙЛ]
+ */
+#include "core/AllocationTracker.hpp"
+#include "model/GameModel.hpp"
+#include "model/CellGenerator.hpp"
+#include "model/CellArena.hpp"
+#include "model/FairBoardGenerator.hpp"
+#include "model/InteractionHandler.hpp"
+#include "controller/MenuController.hpp"
+#include "view/ConsoleRenderer.hpp"
+#include "view/CountingSink.hpp"
+#include "view/Settings.hpp"
+#include "view/TerminalGeometry.hpp"
+#include "view/Viewport.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const unsigned int SEED = 20240501; /**< Seed всех полей бенчмарков */
+
+/**
+ * @brief Результат одного бенчмарка
+ */
+struct BenchResult {
+    std::string name;                  /**< Имя */
+    unsigned long long operations = 0; /**< Выполнено операций */
+    double nsPerOp = 0;                /**< Наносекунд на операцию */
+    double allocsPerOp = 0;            /**< Выделений памяти на операцию */
+    double bytesPerOp = 0;             /**< Байт выделений на операцию */
+    double outputBytesPerOp = -1;      /**< Байт вывода в терминал на операцию (-1 - не измерялось) */
+};
+
+/**
+ * @brief Набор бенчмарков
+ */
+class BenchSuite {
+private:
+    std::string _filter;              /**< Подстрока имени для отбора */
+    double _minTimeMs;                /**< Наименьшее суммарное время замера */
+    std::vector<BenchResult> _results; /**< Результаты */
+    CountingSink* _sink;              /**< Приемник вывода рендерера (для байт вывода) */
+
+public:
+    BenchSuite(const std::string& filter, double minTimeMs): _filter(filter), _minTimeMs(minTimeMs),
+        _sink(nullptr) {}
+
+    /**
+     * @brief Подключает приемник, байты которого считаются выводом операции
+     * @param sink Приемник (nullptr - вывод не измеряется)
+     */
+    void setSink(CountingSink* sink) { _sink = sink; }
+
+    /**
+     * @brief Выполняет бенчмарк
+     * @param name Имя
+     * @param batch Операций в пачке
+     * @param setup Подготовка пачки (не замеряется)
+     * @param operation Операция; получает номер в пачке
+     */
+    template <typename Setup, typename Operation>
+    void run(const std::string& name, size_t batch, Setup setup, Operation operation) {
+        if (!_filter.empty() && name.find(_filter) == std::string::npos) {
+            return;
+        }
+
+        // Прогрев: первая пачка заполняет кэши и буферы, которые дальше переиспользуются
+        setup();
+        for (size_t i = 0; i < batch; i++) {
+            operation(i);
+        }
+
+        BenchResult result;
+        result.name = name;
+        double elapsedNs = 0;
+        unsigned long long allocations = 0;
+        unsigned long long bytes = 0;
+        unsigned long long output = 0;
+
+        while (elapsedNs < _minTimeMs * 1e6) {
+            setup();
+            unsigned long long outputBefore = _sink != nullptr ? _sink->getBytes() : 0;
+            AllocationTracker::Counters before = AllocationTracker::total();
+            auto start = std::chrono::steady_clock::now();
+
+            for (size_t i = 0; i < batch; i++) {
+                operation(i);
+            }
+
+            auto finish = std::chrono::steady_clock::now();
+            AllocationTracker::Counters after = AllocationTracker::total();
+            allocations += after.allocations - before.allocations;
+            bytes += after.bytes - before.bytes;
+            if (_sink != nullptr) {
+                output += _sink->getBytes() - outputBefore;
+            }
+            elapsedNs += std::chrono::duration<double, std::nano>(finish - start).count();
+            result.operations += batch;
+        }
+
+        double operations = static_cast<double>(result.operations);
+        result.nsPerOp = elapsedNs / operations;
+        result.allocsPerOp = allocations / operations;
+        result.bytesPerOp = bytes / operations;
+        if (_sink != nullptr) {
+            result.outputBytesPerOp = output / operations;
+        }
+        _results.push_back(result);
+        std::cerr << name << ": " << std::fixed << std::setprecision(1) << result.nsPerOp << " ns/op" << std::endl;
+    }
+
+    /**
+     * @brief Печатает результаты в JSON
+     * @param out Поток вывода
+     */
+    void writeJson(std::ostream& out) const {
+        out << std::fixed << std::setprecision(3);
+        out << "{\n  \"seed\": " << SEED << ",\n  \"min_time_ms\": " << _minTimeMs << ",\n";
+#ifdef NDEBUG
+        out << "  \"optimized\": true,\n";
+#else
+        out << "  \"optimized\": false,\n";
+#endif
+        out << "  \"benchmarks\": [";
+        for (size_t i = 0; i < _results.size(); i++) {
+            const BenchResult& result = _results[i];
+            out << (i == 0 ? "\n" : ",\n");
+            out << "    {\"name\": \"" << result.name << "\", \"operations\": " << result.operations
+                << ", \"ns_per_op\": " << result.nsPerOp
+                << ", \"allocs_per_op\": " << result.allocsPerOp
+                << ", \"bytes_per_op\": " << result.bytesPerOp;
+            if (result.outputBytesPerOp >= 0) {
+                out << ", \"output_bytes_per_op\": " << result.outputBytesPerOp;
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+};
+
+/**
+ * @brief Строит поле 3 x width, где средняя строка состоит из клеток одного типа
+ * @param width Ширина поля
+ * @param type Тип клеток средней строки
+ * @param score Начальный счет
+ * @return Состояние с игроком в левой клетке средней строки
+ * @note Телепорты чередуются с обычными клетками и переносят на соседнюю справа,
+ * поэтому каждый ход вправо проходит ровно одну клетку заданного типа
+ */
+GameState lineState(int width, CellType type, int score) {
+    GameState state;
+    state.width = width;
+    state.height = 3;
+    state.score = score;
+    state.playerPosition = Position(0, 1);
+
+    for (int y = 0; y < state.height; y++) {
+        for (int x = 0; x < width; x++) {
+            CellType cellType = CellType::BASIC;
+            int targetX = 0;
+            if (y == 1 && x > 0) {
+                if (type == CellType::TELEPORT && x % 2 == 1 && x + 1 < width) {
+                    cellType = CellType::TELEPORT;
+                    targetX = x + 1;
+                } else if (type == CellType::BOMB) {
+                    cellType = CellType::BOMB;
+                }
+            }
+            state.cellTypes.push_back(static_cast<int>(cellType));
+            state.cellValues.push_back(cellType == CellType::BASIC ? 1 : 0);
+            state.cellColors.push_back(static_cast<int>(Color::BLUE));
+            state.cellAvailable.push_back(1);
+            state.teleportTargetsX.push_back(targetX);
+            state.teleportTargetsY.push_back(1);
+        }
+    }
+    return state;
+}
+
+/**
+ * @brief Замеряет ходы вправо по строке клеток одного типа
+ * @param suite Набор бенчмарков
+ * @param name Имя бенчмарка
+ * @param type Тип клеток
+ * @param width Ширина поля
+ * @param score Начальный счет (бомбы отнимают 20% + 9 за ход)
+ */
+void benchMoves(BenchSuite& suite, const std::string& name, CellType type, int width, int score) {
+    GameModel model(width, 3, SEED);
+    GameState state = lineState(width, type, score);
+    size_t moves = type == CellType::TELEPORT ? static_cast<size_t>(width - 1) / 2 : static_cast<size_t>(width - 1);
+
+    suite.run(name, moves,
+        [&]() {
+            if (!state.restore(model)) {
+                throw std::runtime_error("Invalid benchmark board | benchMoves()");
+            }
+        },
+        [&](size_t) {
+            model.makeMove(Direction::RIGHT);
+        });
+
+    if (model.isGameOver()) {
+        throw std::runtime_error("Benchmark board ended the game early: " + name + " | benchMoves()");
+    }
+}
+
+/**
+ * @brief Замеряет полный и инкрементальный кадр рендерера
+ * @param suite Набор бенчмарков
+ * @param sink Приемник вывода, подключенный к std::cout
+ * @param size Размер поля
+ */
+void benchRenderer(BenchSuite& suite, CountingSink& sink, int size) {
+    GameModel model(size, size, SEED);
+    Settings settings;
+    Position window = settings.calculateViewportSize(size, size);
+    Viewport viewport(size, size, window.getX(), window.getY());
+    viewport.centerOn(model.getPlayerPosition());
+    ConsoleRenderer renderer(settings.calculateCenteringOffsets(viewport.getWidth(), viewport.getHeight()), &viewport);
+
+    // Кадр хода перерисовывает клетки, затронутые реальным ходом с этого поля
+    std::vector<std::pair<bool, Position>>& moves = model.getAvailableMoves();
+    Direction directions[4] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+    for (size_t i = 0; i < moves.size() && i < 4; i++) {
+        if (moves[i].first) {
+            model.makeMove(directions[i]);
+            break;
+        }
+    }
+    std::vector<Position> affected = model.getAffectedElements();
+
+    suite.setSink(&sink);
+    std::string suffix = "/" + std::to_string(size);
+    suite.run("render_full_frame" + suffix, 16, []() {}, [&](size_t) {
+        renderer.drawStartingState(model.getGrid());
+        renderer.drawPlayer(model.getPlayerPosition());
+        std::cout.flush();
+    });
+    suite.run("render_move_frame" + suffix, 256, []() {}, [&](size_t) {
+        renderer.drawMove(model.getGrid(), affected);
+        renderer.drawPlayer(model.getPlayerPosition());
+        std::cout.flush();
+    });
+    suite.setSink(nullptr);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string outPath;
+    double minTimeMs = 200;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && std::strcmp(argv[i], "--filter") == 0) {
+            filter = argv[++i];
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--min-time-ms") == 0) {
+            minTimeMs = std::stod(argv[++i]);
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--out") == 0) {
+            outPath = argv[++i];
+        } else {
+            std::cerr << "Usage: greed_bench [--filter SUBSTRING] [--min-time-ms N] [--out FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    BenchSuite suite(filter, minTimeMs);
+
+    try {
+        const int sizes[] = {25, 100, 300};
+        for (int size: sizes) {
+            CellGenerator generator;
+            CellArena arena;
+            std::vector<ICell*> cells;
+            suite.run("generate_random_grid/" + std::to_string(size), 1,
+                [&]() {
+                    for (ICell* cell: cells) {
+                        cell->~ICell();
+                    }
+                    cells.clear();
+                    arena.reset();
+                },
+                [&](size_t) {
+                    cells = generator.generateRandomGrid(size, size, SEED, arena);
+                });
+            for (ICell* cell: cells) {
+                cell->~ICell();
+            }
+        }
+
+        benchMoves(suite, "make_move/basic", CellType::BASIC, 257, 0);
+        benchMoves(suite, "make_move/teleport", CellType::TELEPORT, 257, 0);
+        benchMoves(suite, "make_move/bomb", CellType::BOMB, 33, 2000000000);
+
+        {
+            GameModel model(25, 25, SEED);
+            InteractionHandler handler(model);
+            std::vector<Position> path;
+            suite.run("make_over", 1024, []() {}, [&](size_t i) {
+                int distance = static_cast<int>(i % 9) + 1;
+                handler.makeOver(Position(12, 12), Position(12 + distance, 12), path);
+            });
+        }
+
+        for (int size: {25, 100}) {
+            GameModel model(size, size, SEED);
+            GameModel loaded(size, size, SEED + 1);
+            GameState saved;
+            GameState restored;
+            std::stringstream buffer;
+            suite.run("save_load_roundtrip/" + std::to_string(size), 1,
+                [&]() {
+                    buffer.str(std::string());
+                    buffer.clear();
+                },
+                [&](size_t) {
+                    saved.capture(model);
+                    saved.serialize(buffer);
+                    restored.deserialize(buffer);
+                    restored.restore(loaded);
+                });
+            if (loaded.getScore() != model.getScore() || !(loaded.getPlayerPosition() == model.getPlayerPosition())) {
+                throw std::runtime_error("Save/load round-trip changed the game | main()");
+            }
+        }
+
+        {
+            // Без ограничения времени поиск не зависит от числа потоков: одно и то же
+            // зерно дает одно и то же поле, и это поле заново проходит требования
+            BoardConstraints constraints;
+            FairBoardGenerator serial(1, 4096, std::chrono::milliseconds(60000));
+            FairBoardGenerator pooled(0, 4096, std::chrono::milliseconds(60000));
+            FairBoardResult first = serial.generate(25, 25, SEED, constraints);
+            FairBoardResult second = pooled.generate(25, 25, SEED, constraints);
+            if (!first.satisfied) {
+                throw std::runtime_error("Fair board search found no board for the benchmark seed | main()");
+            }
+            if (second.seed != first.seed || second.satisfied != first.satisfied ||
+                second.report.reachable != first.report.reachable) {
+                throw std::runtime_error("Fair board search depends on the thread count | main()");
+            }
+
+            BoardAnalyzer analyzer;
+            BoardReport report = analyzer.analyze(Grid(25, 25, first.seed));
+            if (!FairBoardGenerator::satisfies(report, constraints) ||
+                report.greedyScore != first.report.greedyScore || report.reachable != first.report.reachable) {
+                throw std::runtime_error("Fair board does not reproduce from its seed | main()");
+            }
+
+            // Замер - с бюджетом времени, с которым генератор работает при старте партии
+            FairBoardGenerator generator;
+            suite.run("fair_board/25", 1, []() {}, [&](size_t) {
+                generator.generate(25, 25, SEED, constraints);
+            });
+        }
+
+        // Рендерер пишет в std::cout: на время замеров вывод уходит в счетчик байт
+        TerminalGeometry::setFixedSize(TerminalSize{120, 40});
+        CountingSink sink;
+        std::streambuf* original = std::cout.rdbuf(&sink);
+        try {
+            benchRenderer(suite, sink, 25);
+            benchRenderer(suite, sink, 300);
+        } catch (...) {
+            std::cout.rdbuf(original);
+            TerminalGeometry::releaseFixedSize();
+            throw;
+        }
+        std::cout.rdbuf(original);
+        TerminalGeometry::releaseFixedSize();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (outPath.empty()) {
+        suite.writeJson(std::cout);
+        return 0;
+    }
+
+    std::ofstream file(outPath);
+    if (!file.is_open()) {
+        std::cerr << "Error: cannot write " << outPath << std::endl;
+        return 1;
+    }
+    suite.writeJson(file);
+    return 0;
+}
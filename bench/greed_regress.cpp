@@ -0,0 +1,517 @@
+/**
+ * @file greed_regress.cpp
+ * @brief Регрессионный прогон движка и рендерера по эталонному набору партий
+ *
+ * Каждая партия набора - размер поля, seed и сценарий ходов (w/a/s/d).
+ * Партия проигрывается через GameModel и синхронный GameView так же, как
+ * ее ведет GameController: подсветка направления, ход, кадр хода. Итоговое
+ * состояние модели и итоговый экран VirtualTerminal сравниваются с
+ * эталонными хешами, а время партии (без генерации поля) - с бюджетом:
+ * партия повторяется --repeat раз, берутся медиана и MAD, и регрессией
+ * считается только медиана, превысившая бюджет больше чем на
+ * NOISE_MADS отклонений. Бюджеты записаны для сборки Release; в сборке
+ * без NDEBUG время печатается, но не проверяется.
+ *
+ * Запуск: greed_regress [--corpus ФАЙЛ] [--filter ПОДСТРОКА] [--repeat N]
+ *                       [--budget-scale K] [--no-timing] [--record]
+ * Поле каждой партии также проверяется BoardAnalyzer (столбец board): отчет
+ * analyzeBoards совпадает с последовательным analyze, число доступных клеток -
+ * с полем, каждая клетка сценария отмечена достижимой, а на полях до
+ * GREEDY_REPLAY_MAX_SIZE жадное прохождение анализатора повторяется через
+ * GameModel::makeMove с тем же счетом и числом ходов.
+ *
+ * Код завершения: 0 - регрессий нет, 1 - регрессия, 2 - ошибка набора или аргументов.
+ * --record переписывает набор текущими хешами и бюджетами (медиана * RECORD_HEADROOM).
+ */
+#include "controller/MenuController.hpp"
+#include "model/BoardAnalyzer.hpp"
+#include "model/GameModel.hpp"
+#include "view/CountingSink.hpp"
+#include "view/GameView.hpp"
+#include "view/TerminalGeometry.hpp"
+#include "view/VirtualTerminal.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef GREED_REGRESS_CORPUS
+#define GREED_REGRESS_CORPUS "bench/regress_corpus.txt"
+#endif
+
+namespace {
+
+const TerminalSize TERMINAL = {120, 40}; /**< Размер виртуального терминала всех партий */
+const double NOISE_MADS = 3.0;           /**< Во сколько MAD медиана может превысить бюджет без регрессии */
+const double RECORD_HEADROOM = 2.0;      /**< Запас бюджета над медианой при --record */
+const int GREEDY_REPLAY_MAX_SIZE = 100;  /**< Наибольший размер поля, на котором жадное прохождение повторяется через GameModel */
+const Direction MOVE_DIRECTIONS[4] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT}; /**< Порядок перебора ходов (как в BoardAnalyzer) */
+
+/**
+ * @brief Партия эталонного набора
+ */
+struct RegressCase {
+    std::string name;       /**< Имя */
+    int size = 0;           /**< Размер поля */
+    unsigned int seed = 0;  /**< Seed поля */
+    double budgetUs = 0;    /**< Бюджет времени партии, мкс */
+    std::string stateHash;  /**< Эталонный хеш состояния модели */
+    std::string screenHash; /**< Эталонный хеш итогового экрана */
+    std::string script;     /**< Ходы: w, a, s, d */
+};
+
+/**
+ * @brief Результат одного проигрыша партии
+ */
+struct Playthrough {
+    int moves = 0;          /**< Выполнено ходов */
+    std::string stateHash;  /**< Хеш состояния модели */
+    std::string screenHash; /**< Хеш экрана (только при выводе в VirtualTerminal) */
+    double elapsedUs = 0;   /**< Время от начального кадра до последнего кадра хода */
+};
+
+/**
+ * @brief Хеш FNV-1a (64 бита)
+ */
+class Fnv1a {
+private:
+    uint64_t _hash = 14695981039346656037ull; /**< Текущее значение */
+
+public:
+    void add(const void* data, size_t length) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < length; i++) {
+            _hash ^= bytes[i];
+            _hash *= 1099511628211ull;
+        }
+    }
+
+    template <typename T>
+    void add(const T& value) { add(&value, sizeof(value)); }
+
+    std::string hex() const {
+        std::ostringstream out;
+        out << std::hex << std::setw(16) << std::setfill('0') << _hash;
+        return out.str();
+    }
+};
+
+/**
+ * @brief Хеширует состояние модели в формате сохранения
+ * @param model Модель игры
+ * @note Формат сохранения не зависит от раскладки поля в памяти, поэтому хеш переживает ее замену
+ */
+std::string hashState(const GameModel& model) {
+    GameState state;
+    state.capture(model);
+    std::ostringstream buffer;
+    state.serialize(buffer);
+
+    std::string bytes = buffer.str();
+    Fnv1a hash;
+    hash.add(bytes.data(), bytes.size());
+    bool gameOver = model.isGameOver();
+    hash.add(gameOver);
+    return hash.hex();
+}
+
+/**
+ * @brief Хеширует экран виртуального терминала
+ * @param terminal Виртуальный терминал
+ */
+std::string hashScreen(const VirtualTerminal& terminal) {
+    Fnv1a hash;
+    for (int y = 0; y < terminal.getRows(); y++) {
+        for (int x = 0; x < terminal.getColumns(); x++) {
+            const TerminalCell& cell = terminal.at(x, y);
+            hash.add(cell.glyph);
+            hash.add(cell.fg);
+            hash.add(cell.bg);
+            hash.add(cell.attrs);
+        }
+    }
+    return hash.hex();
+}
+
+/**
+ * @brief Переводит символ сценария в направление
+ * @param move Символ w, a, s или d
+ * @throws std::runtime_error для других символов
+ */
+Direction directionOf(char move) {
+    switch (move) {
+        case 'w': return Direction::UP;
+        case 's': return Direction::DOWN;
+        case 'a': return Direction::LEFT;
+        case 'd': return Direction::RIGHT;
+        default:
+            throw std::runtime_error(std::string("Unknown move '") + move + "' | directionOf()");
+    }
+}
+
+/**
+ * @brief Сверяет отчет BoardAnalyzer с движком на поле партии
+ * @param regressCase Партия
+ * @param report Отчет, полученный BoardAnalyzer::analyzeBoards
+ * @return Пустая строка при совпадении, иначе описание первого расхождения
+ */
+std::string checkBoardAnalysis(const RegressCase& regressCase, const BoardReport& report) {
+    GameModel model(regressCase.size, regressCase.size, regressCase.seed);
+    const Grid& grid = model.getGrid();
+
+    BoardAnalyzer analyzer;
+    BoardReport serial = analyzer.analyze(grid);
+    if (serial.availableCells != report.availableCells || serial.reachableCells != report.reachableCells ||
+        serial.deadCells != report.deadCells || serial.greedyScore != report.greedyScore ||
+        serial.greedyMoves != report.greedyMoves || serial.reachable != report.reachable) {
+        return "analyzeBoards differs from analyze";
+    }
+
+    int available = 0;
+    for (int y = 0; y < grid.getHeight(); y++) {
+        for (int x = 0; x < grid.getWidth(); x++) {
+            available += grid[Position(x, y)].isAvailable() ? 1 : 0;
+        }
+    }
+    if (available != report.availableCells) {
+        return "available cells " + std::to_string(report.availableCells) + ", grid has " + std::to_string(available);
+    }
+
+    int moves = 0;
+    for (char move: regressCase.script) {
+        model.makeMove(directionOf(move));
+        moves++;
+        if (model.isGameOver()) {
+            break;
+        }
+        Position player = model.getPlayerPosition();
+        if (!report.reachable[static_cast<size_t>(player.getY()) * grid.getWidth() + player.getX()]) {
+            return "move " + std::to_string(moves) + " lands on a cell marked unreachable";
+        }
+    }
+
+    if (regressCase.size > GREEDY_REPLAY_MAX_SIZE) {
+        return "";
+    }
+
+    // Тот же жадный выбор, что в BoardAnalyzer::greedyPlayout: пробный ход
+    // делается на копии состояния, побеждает первый ход с наибольшим приростом
+    GameModel greedy(regressCase.size, regressCase.size, regressCase.seed);
+    GameModel trial(regressCase.size, regressCase.size, regressCase.seed);
+    GameState state;
+    int greedyMoves = 0;
+    while (greedyMoves < regressCase.size * regressCase.size) {
+        state.capture(greedy);
+        int bestGain = std::numeric_limits<int>::min();
+        Direction bestDirection = Direction::NONE;
+        for (Direction direction: MOVE_DIRECTIONS) {
+            state.restore(trial);
+            trial.makeMove(direction);
+            int gain = trial.getScore() - greedy.getScore();
+            if (!trial.isGameOver() && gain > bestGain) {
+                bestGain = gain;
+                bestDirection = direction;
+            }
+        }
+        if (bestDirection == Direction::NONE) {
+            break;
+        }
+        greedy.makeMove(bestDirection);
+        greedyMoves++;
+    }
+    if (greedy.getScore() != report.greedyScore || greedyMoves != report.greedyMoves) {
+        return "greedy playout " + std::to_string(report.greedyScore) + "/" + std::to_string(report.greedyMoves) +
+               ", engine " + std::to_string(greedy.getScore()) + "/" + std::to_string(greedyMoves);
+    }
+    return "";
+}
+
+/**
+ * @brief Проигрывает партию с выводом в заданный приемник
+ * @param regressCase Партия
+ * @param sink Приемник вывода (CountingSink для замеров, VirtualTerminal для хеша экрана)
+ * @param screen Тот же приемник, если это VirtualTerminal: его экран хешируется до выхода
+ * GameView из альтернативного экрана (nullptr - без хеша экрана)
+ * @return Результат проигрыша
+ */
+Playthrough play(const RegressCase& regressCase, CountingSink& sink, const VirtualTerminal* screen = nullptr) {
+    Playthrough result;
+    std::cout.flush();
+    std::streambuf* original = std::cout.rdbuf(&sink);
+
+    try {
+        GameModel model(regressCase.size, regressCase.size, regressCase.seed);
+        GameView view(&model);
+
+        auto start = std::chrono::steady_clock::now();
+        view.renderStatringState();
+        for (char move: regressCase.script) {
+            if (model.isGameOver()) {
+                break;
+            }
+            Direction direction = directionOf(move);
+            view.highlightMoveDirection(model.getAvailableMoves(), direction);
+            model.makeMove(direction);
+            view.renderMove();
+            std::cout.flush();
+            result.moves++;
+        }
+        result.elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        result.stateHash = hashState(model);
+        if (screen != nullptr) {
+            result.screenHash = hashScreen(*screen);
+        }
+    } catch (...) {
+        std::cout.rdbuf(original);
+        throw;
+    }
+
+    std::cout.flush();
+    std::cout.rdbuf(original);
+    return result;
+}
+
+/**
+ * @brief Возвращает медиану
+ * @param values Значения (копия сортируется)
+ */
+double median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+/**
+ * @brief Возвращает медианное абсолютное отклонение
+ * @param values Значения
+ * @param center Медиана значений
+ */
+double medianAbsoluteDeviation(const std::vector<double>& values, double center) {
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (double value: values) {
+        deviations.push_back(std::fabs(value - center));
+    }
+    return median(deviations);
+}
+
+/**
+ * @brief Читает эталонный набор
+ * @param path Путь к файлу набора
+ * @param header Строки комментариев из начала файла (для --record)
+ * @throws std::runtime_error если файл не открылся или строка не разобралась
+ */
+std::vector<RegressCase> loadCorpus(const std::string& path, std::vector<std::string>& header) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open corpus " + path + " | loadCorpus()");
+    }
+
+    std::vector<RegressCase> cases;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            if (cases.empty()) {
+                header.push_back(line);
+            }
+            continue;
+        }
+
+        std::istringstream fields(line);
+        RegressCase regressCase;
+        if (!(fields >> regressCase.name >> regressCase.size >> regressCase.seed >> regressCase.budgetUs
+                     >> regressCase.stateHash >> regressCase.screenHash >> regressCase.script)) {
+            throw std::runtime_error("Malformed corpus line " + std::to_string(lineNumber) + " | loadCorpus()");
+        }
+        cases.push_back(regressCase);
+    }
+    return cases;
+}
+
+/**
+ * @brief Записывает эталонный набор
+ * @param path Путь к файлу набора
+ * @param header Строки комментариев для начала файла
+ * @param cases Партии
+ * @throws std::runtime_error если файл не записался
+ */
+void saveCorpus(const std::string& path, const std::vector<std::string>& header, const std::vector<RegressCase>& cases) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot write corpus " + path + " | saveCorpus()");
+    }
+
+    for (const std::string& line: header) {
+        file << line << "\n";
+    }
+    for (const RegressCase& regressCase: cases) {
+        file << regressCase.name << " " << regressCase.size << " " << regressCase.seed << " "
+             << static_cast<long long>(std::ceil(regressCase.budgetUs)) << " "
+             << regressCase.stateHash << " " << regressCase.screenHash << " " << regressCase.script << "\n";
+    }
+    if (!file.good()) {
+        throw std::runtime_error("Failed to write corpus " + path + " | saveCorpus()");
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string corpusPath = GREED_REGRESS_CORPUS;
+    std::string filter;
+    int repeat = 11;
+    double budgetScale = 1.0;
+    bool timing = true;
+    bool record = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && std::strcmp(argv[i], "--corpus") == 0) {
+            corpusPath = argv[++i];
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--filter") == 0) {
+            filter = argv[++i];
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--repeat") == 0) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--budget-scale") == 0) {
+            budgetScale = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--no-timing") == 0) {
+            timing = false;
+        } else if (std::strcmp(argv[i], "--record") == 0) {
+            record = true;
+        } else {
+            std::cerr << "Usage: greed_regress [--corpus FILE] [--filter SUBSTRING] [--repeat N]"
+                      << " [--budget-scale K] [--no-timing] [--record]" << std::endl;
+            return 2;
+        }
+    }
+
+#ifndef NDEBUG
+    if (timing && !record) {
+        std::cerr << "Note: budgets are recorded for Release builds; timings are reported but not checked" << std::endl;
+    }
+    bool enforceBudgets = false;
+#else
+    bool enforceBudgets = timing;
+#endif
+
+    std::vector<std::string> header;
+    std::vector<RegressCase> cases;
+    int regressions = 0;
+
+    TerminalGeometry::setFixedSize(TERMINAL);
+    try {
+        cases = loadCorpus(corpusPath, header);
+
+        // Поля всех партий анализируются параллельно, как при отборе полей
+        std::vector<std::unique_ptr<GameModel>> boards;
+        std::vector<const Grid*> grids;
+        for (const RegressCase& regressCase: cases) {
+            boards.push_back(std::make_unique<GameModel>(regressCase.size, regressCase.size, regressCase.seed));
+            grids.push_back(&boards.back()->getGrid());
+        }
+        std::vector<BoardReport> reports = BoardAnalyzer::analyzeBoards(grids);
+        boards.clear();
+
+        std::cout << std::left << std::setw(14) << "case" << std::right << std::setw(6) << "moves"
+                  << std::setw(8) << "state" << std::setw(8) << "screen" << std::setw(8) << "board"
+                  << std::setw(12) << "median_us" << std::setw(10) << "mad_us"
+                  << std::setw(12) << "budget_us" << "  result\n";
+
+        for (size_t caseIndex = 0; caseIndex < cases.size(); caseIndex++) {
+            RegressCase& regressCase = cases[caseIndex];
+            if (!filter.empty() && regressCase.name.find(filter) == std::string::npos) {
+                continue;
+            }
+
+            // Экран разбирается только в отдельном проигрыше: разбор не должен попадать в замер
+            VirtualTerminal terminal(TERMINAL.columns, TERMINAL.rows);
+            Playthrough reference = play(regressCase, terminal, &terminal);
+
+            std::vector<double> samples;
+            bool deterministic = true;
+            if (timing) {
+                play(regressCase, terminal); // Прогрев
+                for (int i = 0; i < repeat; i++) {
+                    CountingSink sink;
+                    Playthrough run = play(regressCase, sink);
+                    samples.push_back(run.elapsedUs);
+                    deterministic = deterministic && run.stateHash == reference.stateHash;
+                }
+            }
+            double center = median(samples);
+            double spread = medianAbsoluteDeviation(samples, center);
+            double budget = regressCase.budgetUs * budgetScale;
+
+            bool stateOk = deterministic && reference.stateHash == regressCase.stateHash;
+            bool screenOk = reference.screenHash == regressCase.screenHash;
+            std::string boardIssue = checkBoardAnalysis(regressCase, reports[caseIndex]);
+            bool boardOk = boardIssue.empty();
+            bool slow = timing && center > budget;
+            bool overBudget = slow && center - NOISE_MADS * spread > budget;
+
+            std::string result = "ok";
+            if (record) {
+                regressCase.stateHash = reference.stateHash;
+                regressCase.screenHash = reference.screenHash;
+                if (timing) {
+                    regressCase.budgetUs = center * RECORD_HEADROOM;
+                }
+                result = "recorded";
+            } else if (!stateOk || !screenOk || !boardOk || (enforceBudgets && overBudget)) {
+                result = !deterministic ? "NONDETERMINISTIC" :
+                         (!stateOk ? "STATE" : (!screenOk ? "SCREEN" : (!boardOk ? "BOARD" : "SLOW")));
+                regressions++;
+            } else if (slow) {
+                result = enforceBudgets ? "ok (over budget within noise)" : "ok (over budget, not checked)";
+            }
+
+            std::cout << std::left << std::setw(14) << regressCase.name << std::right
+                      << std::setw(6) << reference.moves
+                      << std::setw(8) << (stateOk ? "ok" : "FAIL") << std::setw(8) << (screenOk ? "ok" : "FAIL")
+                      << std::setw(8) << (boardOk ? "ok" : "FAIL")
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(12) << center << std::setw(10) << spread << std::setw(12) << budget
+                      << "  " << result << "\n";
+            if (!stateOk && !record) {
+                std::cout << "  state  expected " << regressCase.stateHash << " got " << reference.stateHash << "\n";
+            }
+            if (!screenOk && !record) {
+                std::cout << "  screen expected " << regressCase.screenHash << " got " << reference.screenHash << "\n";
+            }
+            if (!boardOk) {
+                std::cout << "  board  " << boardIssue << "\n";
+            }
+            std::cout.flush();
+        }
+
+        if (record) {
+            saveCorpus(corpusPath, header, cases);
+            std::cout << "Recorded " << corpusPath << "\n";
+        }
+    } catch (const std::exception& e) {
+        TerminalGeometry::releaseFixedSize();
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    TerminalGeometry::releaseFixedSize();
+
+    if (regressions > 0) {
+        std::cout << regressions << " regression(s)" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file greed.h
+ * @brief Стабильный C ABI движка Greed для встраивания через FFI
+ *
+ * Все функции возвращают код состояния greed_status (кроме функций создания,
+ * возвращающих указатель). Данные о состоянии записываются в буферы,
+ * выделенные вызывающей стороной; шаги игры не выделяют память.
+ */
+#ifndef GREED_C_API
+#define GREED_C_API
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  define GREED_API __declspec(dllexport)
+#else
+#  define GREED_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Версия ABI; увеличивается при любом несовместимом изменении
+ */
+#define GREED_ABI_VERSION 1
+
+/**
+ * @brief Непрозрачный дескриптор игры
+ */
+typedef struct greed_game greed_game;
+
+/**
+ * @brief Коды результата вызовов API
+ */
+typedef enum greed_status {
+    GREED_OK = 0,                   /**< Успешное выполнение */
+    GREED_ERR_INVALID_ARGUMENT = -1, /**< Неверный аргумент (NULL, неизвестное направление и т.д.) */
+    GREED_ERR_BUFFER_TOO_SMALL = -2, /**< Буфер вызывающей стороны слишком мал */
+    GREED_ERR_GAME_OVER = -3,        /**< Игра уже завершена, ход не выполнен */
+    GREED_ERR_CORRUPT_DATA = -4,     /**< Сериализованные данные повреждены */
+    GREED_ERR_INTERNAL = -5          /**< Внутренняя ошибка движка */
+} greed_status;
+
+/**
+ * @brief Направления хода (совпадают с порядком Direction)
+ */
+typedef enum greed_direction {
+    GREED_UP = 0,
+    GREED_DOWN = 1,
+    GREED_LEFT = 2,
+    GREED_RIGHT = 3
+} greed_direction;
+
+/**
+ * @brief Типы клеток (совпадают с кодами файла сохранения)
+ */
+typedef enum greed_cell_type {
+    GREED_CELL_BASIC = 0,
+    GREED_CELL_TELEPORT = 1,
+    GREED_CELL_BOMB = 2
+} greed_cell_type;
+
+/**
+ * @brief Сводное состояние игры
+ */
+typedef struct greed_state {
+    int32_t width;     /**< Ширина поля */
+    int32_t height;    /**< Высота поля */
+    int32_t player_x;  /**< X-координата игрока */
+    int32_t player_y;  /**< Y-координата игрока */
+    int32_t score;     /**< Текущий счет */
+    int32_t game_over; /**< 1 если игра завершена, иначе 0 */
+} greed_state;
+
+/**
+ * @brief Описание одной клетки поля
+ */
+typedef struct greed_cell {
+    uint8_t type;       /**< Тип клетки (greed_cell_type) */
+    uint8_t value;      /**< Значение базовой клетки (0 для специальных) */
+    uint8_t color;      /**< Цвет клетки (значение Color) */
+    uint8_t available;  /**< 1 если клетка доступна */
+    int32_t target_x;   /**< X-цель телепорта (0 для прочих клеток) */
+    int32_t target_y;   /**< Y-цель телепорта (0 для прочих клеток) */
+} greed_cell;
+
+/**
+ * @brief Возвращает версию ABI, с которой собрана библиотека
+ * @return Значение GREED_ABI_VERSION
+ */
+GREED_API int greed_abi_version(void);
+
+/**
+ * @brief Создает новую игру с воспроизводимым полем
+ * @param width Ширина поля (> 0)
+ * @param height Высота поля (> 0)
+ * @param seed Зерно генератора поля
+ * @return Дескриптор игры или NULL при ошибке
+ */
+GREED_API greed_game* greed_create(int32_t width, int32_t height, uint32_t seed);
+
+/**
+ * @brief Уничтожает игру и освобождает все ее ресурсы
+ * @param game Дескриптор игры (NULL допустим)
+ */
+GREED_API void greed_destroy(greed_game* game);
+
+/**
+ * @brief Выполняет один ход
+ * @param game Дескриптор игры
+ * @param direction Направление (greed_direction)
+ * @return GREED_OK, GREED_ERR_GAME_OVER или код ошибки
+ */
+GREED_API int greed_step(greed_game* game, int32_t direction);
+
+/**
+ * @brief Выполняет последовательность ходов за один вызов
+ * @param game Дескриптор игры
+ * @param directions Массив направлений (greed_direction)
+ * @param count Количество направлений
+ * @param applied Количество фактически выполненных ходов (может быть NULL)
+ * @return GREED_OK если выполнены все ходы, GREED_ERR_GAME_OVER если игра
+ *         завершилась раньше, или код ошибки
+ * @note Ходы после завершения игры не выполняются
+ */
+GREED_API int greed_step_batch(greed_game* game, const uint8_t* directions, size_t count, size_t* applied);
+
+/**
+ * @brief Записывает сводное состояние игры
+ * @param game Дескриптор игры
+ * @param out Структура для записи
+ * @return GREED_OK или код ошибки
+ */
+GREED_API int greed_get_state(const greed_game* game, greed_state* out);
+
+/**
+ * @brief Записывает описание всех клеток поля построчно
+ * @param game Дескриптор игры
+ * @param out Буфер на width * height элементов
+ * @param capacity Емкость буфера в элементах
+ * @return GREED_OK или GREED_ERR_BUFFER_TOO_SMALL
+ * @note Стоимость O(width * height): на большом поле, которое хранится тайлами
+ *       и генерируется по мере обхода, вызов генерирует каждый тайл. Для
+ *       видимой части поля используйте greed_get_cells_rect.
+ */
+GREED_API int greed_get_cells(const greed_game* game, greed_cell* out, size_t capacity);
+
+/**
+ * @brief Записывает описание клеток прямоугольной области поля построчно
+ * @param game Дескриптор игры
+ * @param x X-координата левого верхнего угла области
+ * @param y Y-координата левого верхнего угла области
+ * @param w Ширина области (> 0)
+ * @param h Высота области (> 0)
+ * @param out Буфер на w * h элементов
+ * @param capacity Емкость буфера в элементах
+ * @return GREED_OK, GREED_ERR_BUFFER_TOO_SMALL или GREED_ERR_INVALID_ARGUMENT,
+ *         если область выходит за границы поля
+ * @note Стоимость O(w * h): генерируются только тайлы, пересекающие область
+ */
+GREED_API int greed_get_cells_rect(const greed_game* game, int32_t x, int32_t y, int32_t w, int32_t h,
+                                   greed_cell* out, size_t capacity);
+
+/**
+ * @brief Возвращает размер сериализованного состояния в байтах
+ * @param game Дескриптор игры
+ * @return Размер в байтах или 0 при ошибке (в том числе если размер не помещается в size_t)
+ */
+GREED_API size_t greed_serialized_size(const greed_game* game);
+
+/**
+ * @brief Сериализует состояние игры в буфер
+ * @param game Дескриптор игры
+ * @param buffer Буфер для записи
+ * @param capacity Размер буфера в байтах
+ * @param written Количество записанных байт (может быть NULL)
+ * @return GREED_OK, GREED_ERR_BUFFER_TOO_SMALL или GREED_ERR_INVALID_ARGUMENT,
+ *         если размер состояния не помещается в size_t
+ */
+GREED_API int greed_serialize(const greed_game* game, void* buffer, size_t capacity, size_t* written);
+
+/**
+ * @brief Создает игру из сериализованного состояния
+ * @param buffer Данные, полученные от greed_serialize
+ * @param size Размер данных в байтах
+ * @return Дескриптор игры или NULL если данные повреждены
+ * @note Данные проверяются до построения игры: игрок и цели телепортов
+ *       должны лежать внутри поля, тип клетки - быть одним из greed_cell_type,
+ *       значение базовой клетки - не больше 9, цвет - не больше Color::DEFAULT,
+ *       флаги доступности и завершения - 0 или 1
+ */
+GREED_API greed_game* greed_deserialize(const void* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
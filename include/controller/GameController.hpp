@@ -8,10 +8,15 @@
 #include "view/GameView.hpp"
 #include "model/GameModel.hpp"
 #include "controller/InputHandler.hpp"
+#include "controller/InputDecoder.hpp"
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <cstddef>
+#include <csignal>
+
+struct termios;
 
 /**
  * @brief Основной контроллер игры
@@ -31,6 +36,10 @@ private:
     int _minTerminalHeight;               /**< Минимальная высота терминала */
     std::function<void()> _saveCallback;  /**< Callback-функция для сохранения игры */
     std::function<bool()> _menuCallback;  /**< Callback-функция для возврата в меню */
+    std::function<void(std::chrono::steady_clock::time_point)> _moveCallback; /**< Callback-функция после хода */
+    InputDecoder* _input;                 /**< Источник событий клавиатуры */
+    static volatile sig_atomic_t _interrupted; /**< Получен SIGINT (выставляется обработчиком сигнала) */
+    void (*_previousInterrupt)(int);      /**< Обработчик SIGINT до начала игры (восстанавливается при выходе из игры) */
 
 public:
     /**
@@ -62,6 +71,20 @@ public:
      * @param callback Функция возврата в меню
      */
     void setMenuCallback(std::function<bool()> callback);
+
+    /**
+     * @brief Устанавливает callback, вызываемый после каждого хода
+     * @param callback Функция, получающая время разбора клавиши, вызвавшей ход
+     * @note Вызывается после передачи хода представлению; отрисовка может быть еще не завершена
+     */
+    void setMoveCallback(std::function<void(std::chrono::steady_clock::time_point)> callback);
+
+    /**
+     * @brief Подменяет источник ввода
+     * @param input Декодер (по умолчанию - общий декодер stdin)
+     * @note Игровой цикл завершается, когда ввод исчерпан (конец файла или сценария)
+     */
+    void setInputDecoder(InputDecoder* input);
     
     /**
      * @brief Проверяет необходимость возврата в меню
@@ -98,6 +121,20 @@ private:
      * @brief Очищает экран терминала
      */
     void clearScreen();
+
+    /**
+     * @brief Обработчик SIGINT: только выставляет _interrupted
+     * @param sig Номер сигнала
+     */
+    static void onInterrupt(int sig);
+
+    /**
+     * @brief Завершает программу после SIGINT
+     * @param terminal Настройки терминала до начала игры
+     * @note Вызывается из игрового цикла: останавливает поток отрисовки,
+     * восстанавливает терминал и экран, затем вызывает exit(0)
+     */
+    [[noreturn]] void exitOnInterrupt(const struct termios& terminal);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,185 @@
+/**
+ * @file InputDecoder.hpp
+ * @brief Заголовочный файл, содержащий объявление класса InputDecoder
+ */
+#ifndef INPUTDECODER
+#define INPUTDECODER
+
+#include "core/Directions.hpp"
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Событие клавиатуры
+ */
+struct KeyEvent {
+    /**
+     * @brief Вид события
+     */
+    enum Kind {
+        NONE,        /**< Нет события */
+        CHAR,        /**< Печатный или управляющий символ (см. ch) */
+        SPACE,       /**< Пробел */
+        ENTER,       /**< Enter (CR или LF) */
+        ESCAPE,      /**< Одиночный ESC (после таймаута) */
+        UP,          /**< Стрелка вверх */
+        DOWN,        /**< Стрелка вниз */
+        LEFT,        /**< Стрелка влево */
+        RIGHT,       /**< Стрелка вправо */
+        PASTE_BEGIN, /**< Начало вставки (bracketed paste) */
+        PASTE_END,   /**< Конец вставки */
+        UNKNOWN      /**< Нераспознанная ESC-последовательность */
+    };
+
+    Kind kind = NONE;    /**< Вид события */
+    char ch = 0;         /**< Символ для CHAR/SPACE/ENTER */
+    bool pasted = false; /**< Событие пришло внутри вставки и не является командой */
+    std::chrono::steady_clock::time_point time; /**< Время чтения байт, завершивших событие */
+
+    /**
+     * @brief Возвращает символ в нижнем регистре
+     * @return Символ для CHAR (не из вставки), иначе 0
+     */
+    char key() const;
+
+    /**
+     * @brief Преобразует событие в направление
+     * @return Направление для стрелок и WASD (не из вставки), иначе Direction::NONE
+     */
+    Direction direction() const;
+};
+
+/**
+ * @brief Инкрементальный декодер ввода терминала
+ *
+ * Читает stdin блоками в кольцевой буфер и конечным автоматом разбирает
+ * байты в события: стрелки (CSI и SS3), одиночный ESC с таймаутом,
+ * bracketed paste. Незавершенные ESC, ESC [ и ESC O ждут продолжения
+ * не дольше ESCAPE_TIMEOUT_MS. Последовательность, разорванная между чтениями,
+ * собирается по мере поступления байт. Декодер не выделяет память и
+ * общий для всех контроллеров, поэтому байты не теряются при переходе
+ * между меню и игрой.
+ */
+class InputDecoder {
+private:
+    /**
+     * @brief Состояние автомата разбора
+     */
+    enum State {
+        GROUND, /**< Обычные символы */
+        ESC,    /**< Получен ESC */
+        CSI,    /**< Получен ESC [ */
+        SS3     /**< Получен ESC O */
+    };
+
+    static const size_t BUFFER_SIZE = 256; /**< Размер кольцевого буфера (степень двойки) */
+    static const int MAX_PARAMS = 8;       /**< Наибольшая длина параметров CSI */
+
+    int _fd;                                            /**< Дескриптор ввода */
+    unsigned char _buffer[BUFFER_SIZE];                 /**< Кольцевой буфер байт */
+    size_t _head;                                       /**< Позиция чтения */
+    size_t _tail;                                       /**< Позиция записи */
+    State _state;                                       /**< Состояние автомата */
+    char _params[MAX_PARAMS];                           /**< Параметры текущей CSI-последовательности */
+    int _paramLength;                                   /**< Длина параметров */
+    bool _inPaste;                                      /**< Внутри bracketed paste */
+    bool _eof;                                          /**< Источник закончился (или его нет) */
+    std::chrono::steady_clock::time_point _escapeTime;  /**< Время получения ESC */
+    std::chrono::steady_clock::time_point _readTime;    /**< Время последнего чтения (или feed) */
+
+public:
+    static const int ESCAPE_TIMEOUT_MS = 50; /**< Время ожидания продолжения ESC-последовательности */
+
+    /**
+     * @brief Конструктор декодера
+     * @param fd Дескриптор ввода (терминал, файл или канал; -1 - только feed)
+     */
+    explicit InputDecoder(int fd);
+
+    /**
+     * @brief Возвращает общий декодер стандартного ввода
+     * @return Ссылка на декодер
+     */
+    static InputDecoder& forStdin();
+
+    /**
+     * @brief Ожидает следующее событие
+     * @param event Полученное событие
+     * @param timeoutMs Наибольшее время ожидания (отрицательное - без ограничения)
+     * @return true если событие получено
+     */
+    bool waitEvent(KeyEvent& event, int timeoutMs);
+
+    /**
+     * @brief Возвращает событие из уже прочитанных байт
+     * @param event Полученное событие
+     * @return true если событие получено
+     */
+    bool next(KeyEvent& event);
+
+    /**
+     * @brief Читает доступные байты одним вызовом read
+     * @return Количество прочитанных байт
+     */
+    size_t fill();
+
+    /**
+     * @brief Добавляет байты в буфер, как если бы они были прочитаны
+     * @param data Байты
+     * @param length Количество байт
+     * @return Количество принятых байт (ограничено свободным местом)
+     */
+    size_t feed(const char* data, size_t length);
+
+    /**
+     * @brief Отбрасывает прочитанные, но не разобранные байты
+     */
+    void clear();
+
+    /**
+     * @brief Проверяет, исчерпан ли ввод
+     * @return true если источник закончился и все байты разобраны
+     * @note Для терминала всегда false; для файла или сценария - после последнего события
+     */
+    bool exhausted() const { return _eof && buffered() == 0 && _state == GROUND; }
+
+    /**
+     * @brief Проверяет, подключен ли декодер к терминалу
+     * @return true если ввод идет с TTY (а не из файла или сценария)
+     */
+    bool isInteractive() const;
+
+private:
+    /**
+     * @brief Возвращает количество байт в буфере
+     */
+    size_t buffered() const { return _tail - _head; }
+
+    /**
+     * @brief Разбирает символ вне ESC-последовательности
+     * @param byte Байт
+     * @param event Событие
+     */
+    void decodeGround(unsigned char byte, KeyEvent& event) const;
+
+    /**
+     * @brief Завершает CSI-последовательность
+     * @param final Завершающий байт
+     * @param event Событие
+     */
+    void decodeCsi(unsigned char final, KeyEvent& event);
+
+    /**
+     * @brief Возвращает время до истечения таймаута ESC-последовательности
+     * @return Миллисекунды (0 если таймаут истек, -1 если последовательность не начата)
+     */
+    int escapeRemainingMs() const;
+
+    /**
+     * @brief Завершает незавершенную ESC-последовательность по таймауту или концу ввода
+     * @param event Событие: ESCAPE для одиночного ESC, UNKNOWN для оборванных CSI и SS3
+     */
+    void expireSequence(KeyEvent& event);
+};
+
+#endif
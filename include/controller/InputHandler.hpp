@@ -18,6 +18,7 @@ class InputHandler {
 private:
     struct termios _originalTermios; /**< Оригинальные настройки терминала */
     bool _isNonCanonicalMode;        /**< Флаг неканонического режима */
+    bool _exitRequested;             /**< Последний вызов getDirectionFromInput завершился выходом (Esc или конец ввода) */
 
 public:
     /**
@@ -56,11 +57,19 @@ public:
     
     /**
      * @brief Получает направление из пользовательского ввода
-     * @return Направление движения (UP, DOWN, LEFT, RIGHT, NONE)
-     * @note Обрабатывает как обычные клавиши (wasd/стрелки), так и ESC-последовательности
+     * @return Направление движения (UP, DOWN, LEFT, RIGHT) или NONE для пробела и выхода
+     * @note События берутся из общего InputDecoder (wasd и стрелки в любой кодировке).
+     *       Esc и конец ввода (закрытый stdin) возвращают NONE и выставляют isExitRequested(),
+     *       чтобы вызывающий код не ждал ввода, которого уже не будет
      */
     Direction getDirectionFromInput();
 
+    /**
+     * @brief Проверяет, запросил ли последний ввод выход
+     * @return true если getDirectionFromInput вернул NONE из-за Esc или конца ввода
+     */
+    bool isExitRequested() const { return _exitRequested; }
+
     /**
      * @brief Проверяет валидность символа как направления
      * @param input Введенный символ
@@ -74,13 +83,6 @@ public:
      * @return Соответствующее направление движения
      */
     Direction convertToDirection(char input) const;
-    
-    /**
-     * @brief Обрабатывает ESC-последовательности (стрелки)
-     * @param result Направление, полученное из последовательности
-     * @return true если обработана ESC-последовательность, false в противном случае
-     */
-    bool handleEscapeSequence(Direction& result) const;
 };
 
 #endif
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <sstream>
 #include <cstddef>
+#include <csignal>
 
 /**
  * @brief Структура для хранения состояния игры
@@ -33,16 +34,29 @@ struct GameState {
     std::vector<int> teleportTargetsY; /**< Y-координаты целей телепортов */
     
     /**
-     * @brief Сериализует состояние игры в файл
-     * @param file Поток для записи данных
+     * @brief Снимает состояние с модели
+     * @param model Модель игры
      */
-    void serialize(std::ofstream& file) const;
+    void capture(const GameModel& model);
+
+    /**
+     * @brief Восстанавливает модель из состояния
+     * @param model Модель игры того же размера
+     * @return true если состояние применено, false если данные не подходят к полю
+     */
+    bool restore(GameModel& model) const;
+
+    /**
+     * @brief Сериализует состояние игры в поток
+     * @param file Поток для записи данных (файл сохранения или буфер в памяти)
+     */
+    void serialize(std::ostream& file) const;
     
     /**
-     * @brief Десериализует состояние игры из файла
+     * @brief Десериализует состояние игры из потока
      * @param file Поток для чтения данных
      */
-    void deserialize(std::ifstream& file);
+    void deserialize(std::istream& file);
 };
 
 /**
@@ -81,7 +95,8 @@ private:
     int _currentSelectedIndex;                   /**< Текущий выбранный индекс в меню */
     std::vector<std::string> _currentMenuItems;  /**< Текущие пункты меню */
     
-    static MenuController* globalMenuController; /**< Глобальный указатель на контроллер меню (для обработки сигналов) */
+    static volatile sig_atomic_t _resizePending; /**< Получен SIGWINCH, меню нужно перерисовать (выставляется обработчиком сигнала) */
+    static const int RESIZE_POLL_MS = 100;       /**< Период проверки флага изменения размера в цикле меню (мс) */
 
 public:
     /**
@@ -197,10 +212,17 @@ private:
     /**
      * @brief Обработчик изменения размера терминала
      * @param sig Номер сигнала
-     * @note Статический метод для использования в обработчике сигналов
+     * @note Только сбрасывает кэш TerminalGeometry и выставляет _resizePending;
+     *       перерисовка выполняется циклом меню вне обработчика сигнала
      */
     static void handleResize(int sig);
     
+    /**
+     * @brief Забирает отложенный запрос на перерисовку после SIGWINCH
+     * @return true если с прошлой проверки пришел SIGWINCH
+     */
+    static bool takePendingResize();
+    
     /**
      * @brief Проверяет размер терминала
      * @return true если размер достаточен, false в противном случае
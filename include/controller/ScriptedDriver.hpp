@@ -0,0 +1,108 @@
+/**
+ * @file ScriptedDriver.hpp
+ * @brief Заголовочный файл, содержащий объявление класса ScriptedDriver
+ */
+#ifndef SCRIPTEDDRIVER
+#define SCRIPTEDDRIVER
+
+#include "view/TerminalGeometry.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Результат прогона сценария
+ */
+struct ScriptReport {
+    int moves = 0;                            /**< Выполнено ходов */
+    int score = 0;                            /**< Итоговый счет */
+    bool gameOver = false;                    /**< Игра завершилась проигрышем/концом поля */
+    unsigned long long totalBytes = 0;        /**< Всего байт вывода */
+    unsigned long long totalWrites = 0;       /**< Всего сбросов вывода */
+    double elapsedMs = 0;                     /**< Время прогона */
+    std::vector<long long> moveLatencyNs;     /**< Задержка каждого хода: от разбора клавиши до отрисованного кадра */
+    std::vector<unsigned long long> moveBytes; /**< Байт вывода с предыдущего хода (первый включает начальный кадр) */
+    std::vector<unsigned long long> repaintBytes; /**< Байт полной перерисовки после каждого хода (при проверке экрана) */
+    int screenChecks = 0;                     /**< Сравнений экрана с полной перерисовкой */
+    int screenMismatches = 0;                 /**< Сравнений, в которых экраны разошлись */
+    int steadyMoves = 0;                      /**< Ходов после прогрева, учтенных в steadyAllocations */
+    unsigned long long steadyAllocations = 0; /**< Выделений в фазах хода и отрисовки после прогрева */
+    unsigned long long steadyBytes = 0;       /**< Байт, выделенных в фазах хода и отрисовки после прогрева */
+
+    /**
+     * @brief Возвращает перцентиль задержки хода
+     * @param percent Перцентиль (0..100)
+     * @return Задержка в наносекундах (0 если ходов нет)
+     */
+    long long latencyPercentile(double percent) const;
+};
+
+/**
+ * @brief Запуск GameController по сценарию клавиш без терминала
+ *
+ * Сценарий - те же байты, что посылает терминал (wasd, стрелки в виде
+ * ESC-последовательностей, пробел). Он читается общим InputDecoder из
+ * временного файла, вывод направляется в CountingSink, а размер
+ * терминала фиксируется, поэтому прогон воспроизводим в контейнере без TTY.
+ * С проверкой экрана вывод разбирается VirtualTerminal, и после каждого
+ * хода (кроме завершившего игру) экран сравнивается с полной
+ * перерисовкой в отдельный терминал.
+ * После каждого хода драйвер дожидается отрисовки кадра и замеряет
+ * задержку и объем вывода, а в сборке со счетчиком AllocationTracker -
+ * выделения памяти в фазах хода и отрисовки (без проверочной перерисовки).
+ */
+class ScriptedDriver {
+private:
+    int _width;            /**< Ширина поля */
+    int _height;           /**< Высота поля */
+    unsigned int _seed;    /**< Зерно поля */
+    TerminalSize _terminal; /**< Размер виртуального терминала */
+    bool _verifyScreens;    /**< Сравнивать экран после каждого хода с полной перерисовкой */
+
+public:
+    static const int DEFAULT_COLUMNS = 120; /**< Ширина виртуального терминала по умолчанию */
+    static const int DEFAULT_ROWS = 40;     /**< Высота виртуального терминала по умолчанию */
+    static const int WARMUP_MOVES = 3;      /**< Первые ходы, за которые буферы хода и кадра набирают емкость */
+
+    /**
+     * @brief Конструктор драйвера
+     * @param width Ширина поля
+     * @param height Высота поля
+     * @param seed Зерно генератора поля
+     * @param terminal Размер виртуального терминала
+     */
+    ScriptedDriver(int width, int height, unsigned int seed,
+                   TerminalSize terminal = {DEFAULT_COLUMNS, DEFAULT_ROWS});
+
+    /**
+     * @brief Включает проверку экрана после каждого хода
+     * @param verify true - выводить в VirtualTerminal и сравнивать с полной перерисовкой
+     * @note Проверка замедляет прогон; задержки ходов при ней не показательны
+     */
+    void setVerifyScreens(bool verify);
+
+    /**
+     * @brief Прогоняет сценарий из памяти
+     * @param keys Байты нажатий
+     * @return Результат прогона
+     * @throws std::runtime_error если не удалось создать временный файл
+     */
+    ScriptReport run(const std::string& keys) const;
+
+    /**
+     * @brief Прогоняет сценарий из файла
+     * @param path Путь к файлу с байтами нажатий
+     * @return Результат прогона
+     * @throws std::runtime_error если файл не удалось открыть
+     */
+    ScriptReport runFile(const std::string& path) const;
+
+private:
+    /**
+     * @brief Прогоняет сценарий из открытого дескриптора
+     * @param fd Дескриптор с байтами нажатий
+     * @return Результат прогона
+     */
+    ScriptReport runDescriptor(int fd) const;
+};
+
+#endif
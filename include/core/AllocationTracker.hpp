@@ -0,0 +1,117 @@
+/**
+ * @file AllocationTracker.hpp
+ * @brief Заголовочный файл, содержащий объявление класса AllocationTracker и макросов фаз
+ */
+#ifndef ALLOCATIONTRACKER
+#define ALLOCATIONTRACKER
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Счетчики выделений памяти по фазам игрового цикла
+ *
+ * Глобальные operator new/delete подменяются только в сборках с
+ * GREED_ALLOCATION_HOOK (опция CMake GREED_TRACK_ALLOCATIONS для игры,
+ * всегда для greed_bench); без нее счетчики остаются нулевыми, а макросы
+ * фаз не порождают кода. Фаза хранится в thread_local переменной и
+ * задается на время блока, поэтому выделения потока отрисовки и потока
+ * управления не смешиваются. Выделения во вложенной фазе (например,
+ * генерация тайла во время хода) относятся к вложенной.
+ */
+class AllocationTracker {
+public:
+    /**
+     * @brief Фаза, к которой относится выделение
+     */
+    enum Phase {
+        OTHER,      /**< Вне отмеченных фаз (меню, инициализация) */
+        GENERATION, /**< Генерация поля и тайлов */
+        MOVE,       /**< Ход: GameModel::makeMove и подсветка */
+        RENDER,     /**< Отрисовка кадров и экрана паузы */
+        SAVE,       /**< Сохранение и загрузка */
+        PHASE_COUNT /**< Количество фаз */
+    };
+
+    /**
+     * @brief Снимок счетчиков фазы
+     */
+    struct Counters {
+        unsigned long long allocations = 0; /**< Выделений */
+        unsigned long long bytes = 0;       /**< Байт */
+    };
+
+    static const bool HOOKED; /**< Счетчики подключены к operator new в этой сборке */
+
+private:
+    static std::atomic<unsigned long long> _allocations[PHASE_COUNT]; /**< Выделений по фазам */
+    static std::atomic<unsigned long long> _bytes[PHASE_COUNT];       /**< Байт по фазам */
+    static thread_local Phase _phase;                                 /**< Текущая фаза потока */
+
+public:
+    /**
+     * @brief Учитывает выделение в текущей фазе потока
+     * @param bytes Размер выделения
+     * @note Вызывается из подмененного operator new
+     */
+    static void recordAllocation(size_t bytes) {
+        _allocations[_phase].fetch_add(1, std::memory_order_relaxed);
+        _bytes[_phase].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Задает фазу текущего потока
+     * @param phase Новая фаза
+     * @return Предыдущая фаза (для восстановления)
+     */
+    static Phase enter(Phase phase) {
+        Phase previous = _phase;
+        _phase = phase;
+        return previous;
+    }
+
+    /**
+     * @brief Возвращает счетчики фазы
+     * @param phase Фаза
+     */
+    static Counters get(Phase phase);
+
+    /**
+     * @brief Возвращает сумму счетчиков всех фаз
+     */
+    static Counters total();
+
+    /**
+     * @brief Возвращает имя фазы
+     * @param phase Фаза
+     */
+    static const char* phaseName(Phase phase);
+};
+
+/**
+ * @brief Фаза выделений от конструктора до деструктора
+ */
+class AllocationScope {
+private:
+    AllocationTracker::Phase _previous; /**< Фаза, действовавшая до блока */
+
+public:
+    explicit AllocationScope(AllocationTracker::Phase phase): _previous(AllocationTracker::enter(phase)) {}
+    ~AllocationScope() { AllocationTracker::enter(_previous); }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+#define GREED_ALLOCATION_CONCAT_INNER(a, b) a##b
+#define GREED_ALLOCATION_CONCAT(a, b) GREED_ALLOCATION_CONCAT_INNER(a, b)
+
+#ifdef GREED_ALLOCATION_HOOK
+/** Относит выделения до конца блока к фазе AllocationTracker::phase */
+#define GREED_ALLOCATION_PHASE(phase) \
+    AllocationScope GREED_ALLOCATION_CONCAT(_allocationScope, __LINE__)(AllocationTracker::phase)
+#else
+#define GREED_ALLOCATION_PHASE(phase) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,23 @@
+/**
+ * @file CellType.hpp
+ * @brief Заголовочный файл, содержащий перечисление типов клеток
+ */
+#ifndef CELLTYPE
+#define CELLTYPE
+
+#include <cstdint>
+
+/**
+ * @brief Тип клетки поля
+ *
+ * Движок выбирает обработчик взаимодействия по типу клетки (switch), без
+ * виртуального вызова. Числовые значения записываются в файл сохранения
+ * и совпадают с GREED_CELL_* в C API, поэтому их нельзя менять.
+ */
+enum class CellType : uint8_t {
+    BASIC = 0,    /**< Обычная клетка: дает очки и задает длину прыжка своим значением */
+    TELEPORT = 1, /**< Телепорт: переносит игрока на клетку-цель */
+    BOMB = 2      /**< Бомба: отнимает часть счета и останавливает прыжок */
+};
+
+#endif
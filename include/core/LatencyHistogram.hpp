@@ -0,0 +1,103 @@
+/**
+ * @file LatencyHistogram.hpp
+ * @brief Заголовочный файл, содержащий объявление класса LatencyHistogram
+ */
+#ifndef LATENCYHISTOGRAM
+#define LATENCYHISTOGRAM
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Гистограмма задержек в духе HDR Histogram
+ *
+ * Значения (наносекунды) раскладываются по логарифмически-линейным
+ * корзинам: до 2 * SUB_BUCKETS - по одной на значение, дальше каждая
+ * степень двойки делится на SUB_BUCKETS равных корзин, то есть
+ * относительная погрешность не превышает 1 / SUB_BUCKETS. Запись - одно
+ * атомарное сложение без выделения памяти, поэтому один поток может
+ * писать, пока другие читают процентили.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;                 /**< Точность: log2 корзин на степень двойки */
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;  /**< Корзин на степень двойки */
+    static const int MAX_VALUE_BITS = 36;                 /**< Значения от 2^36 нс (~69 с) попадают в последнюю корзину */
+    static const size_t BUCKET_COUNT = 2 * SUB_BUCKETS + (MAX_VALUE_BITS - SUB_BUCKET_BITS - 1) * SUB_BUCKETS; /**< Количество корзин */
+
+private:
+    std::atomic<uint64_t> _counts[BUCKET_COUNT]; /**< Счетчики корзин */
+    std::atomic<uint64_t> _total;                /**< Количество значений */
+    std::atomic<uint64_t> _sum;                  /**< Сумма значений */
+    std::atomic<uint64_t> _max;                  /**< Наибольшее значение */
+
+public:
+    /**
+     * @brief Конструктор пустой гистограммы
+     */
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Добавляет значение
+     * @param nanoseconds Задержка в наносекундах
+     */
+    void record(uint64_t nanoseconds);
+
+    /**
+     * @brief Обнуляет гистограмму
+     */
+    void reset();
+
+    /**
+     * @brief Возвращает количество значений
+     */
+    uint64_t getCount() const { return _total.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает наибольшее значение
+     */
+    uint64_t getMax() const { return _max.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает среднее значение
+     * @return Среднее в наносекундах (0 для пустой гистограммы)
+     */
+    uint64_t getMean() const;
+
+    /**
+     * @brief Возвращает процентиль
+     * @param percent Процент (0..100)
+     * @return Верхняя граница корзины, в которую попал процентиль (не больше максимума)
+     */
+    uint64_t percentile(double percent) const;
+
+    /**
+     * @brief Возвращает счетчик корзины
+     * @param index Индекс корзины
+     */
+    uint64_t getBucketCount(size_t index) const { return _counts[index].load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает индекс корзины для значения
+     * @param value Значение
+     */
+    static size_t bucketIndex(uint64_t value);
+
+    /**
+     * @brief Возвращает наименьшее значение корзины
+     * @param index Индекс корзины
+     */
+    static uint64_t bucketLowerBound(size_t index);
+
+    /**
+     * @brief Возвращает наибольшее значение корзины
+     * @param index Индекс корзины
+     */
+    static uint64_t bucketUpperBound(size_t index) { return bucketLowerBound(index + 1) - 1; }
+};
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file SpscQueue.hpp
+ * @brief Заголовочный файл, содержащий объявление класса SpscQueue
+ */
+#ifndef SPSCQUEUE
+#define SPSCQUEUE
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Очередь без блокировок для одного производителя и одного потребителя
+ *
+ * Кольцевой буфер фиксированного размера: производитель двигает только
+ * _tail, потребитель - только _head, поэтому достаточно пар
+ * release/acquire без мьютексов и выделения памяти.
+ *
+ * @tparam T Тип элемента (копируемый)
+ * @tparam Capacity Емкость очереди (степень двойки)
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+    T _items[Capacity];                  /**< Элементы очереди */
+    alignas(64) std::atomic<size_t> _head; /**< Индекс следующего элемента для чтения (потребитель) */
+    alignas(64) std::atomic<size_t> _tail; /**< Индекс следующей свободной ячейки (производитель) */
+
+public:
+    /**
+     * @brief Конструктор пустой очереди
+     */
+    SpscQueue(): _items(), _head(0), _tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Добавляет элемент (только поток-производитель)
+     * @param item Элемент
+     * @return false если очередь заполнена
+     */
+    bool push(const T& item) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        _items[tail & (Capacity - 1)] = item;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Извлекает элемент (только поток-потребитель)
+     * @param item Извлеченный элемент
+     * @return false если очередь пуста
+     */
+    bool pop(T& item) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = _items[head & (Capacity - 1)];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Проверяет, пуста ли очередь
+     * @return true если элементов нет
+     */
+    bool empty() const {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file Tracer.hpp
+ * @brief Заголовочный файл, содержащий объявление класса Tracer и макросов трассировки
+ */
+#ifndef TRACER
+#define TRACER
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Трассировка фаз игрового цикла в формате Chrome Trace Event
+ *
+ * Отрезки (события "X") пишутся в кольцевой буфер фиксированного размера:
+ * запись - захват слота одним атомарным сложением, без блокировок и
+ * выделения памяти; при переполнении перезаписываются самые старые.
+ * Буфер выделяется только при start(), файл JSON для chrome://tracing и
+ * Perfetto пишется в stop(). Выключенная трассировка стоит одной проверки
+ * флага, а без GREED_TRACING (сборка Release) макросы не порождают кода.
+ */
+class Tracer {
+public:
+    static const size_t CAPACITY = 1 << 16; /**< Размер кольцевого буфера (степень двойки) */
+    static const int MAX_THREADS = 8;       /**< Наибольшее число именованных потоков */
+
+    /**
+     * @brief Событие трассировки
+     */
+    struct Event {
+        const char* category; /**< Категория (строковый литерал) */
+        const char* name;     /**< Имя отрезка (строковый литерал) */
+        uint64_t start;       /**< Начало, нс от start() */
+        uint64_t duration;    /**< Длительность, нс (для мгновенного события - 0) */
+        uint32_t thread;      /**< Номер потока */
+        bool instant;         /**< Мгновенное событие ("i") вместо отрезка ("X") */
+    };
+
+private:
+    static std::atomic<bool> _enabled;                   /**< Трассировка включена */
+    static std::unique_ptr<Event[]> _events;             /**< Кольцевой буфер событий */
+    static std::atomic<uint64_t> _next;                  /**< Счетчик записанных событий */
+    static std::atomic<uint32_t> _threads;               /**< Счетчик выданных номеров потоков */
+    static std::atomic<const char*> _threadNames[MAX_THREADS]; /**< Имена потоков по номерам */
+    static std::chrono::steady_clock::time_point _origin; /**< Начало отсчета времени */
+    static std::string _path;                            /**< Файл для записи трассы */
+
+public:
+    /**
+     * @brief Включает трассировку
+     * @param path Файл, в который stop() запишет трассу
+     * @note Повторный вызов при включенной трассировке игнорируется
+     */
+    static void start(const std::string& path);
+
+    /**
+     * @brief Выключает трассировку и записывает трассу в файл
+     * @return true если файл записан (false если трассировка не была включена)
+     */
+    static bool stop();
+
+    /**
+     * @brief Проверяет, включена ли трассировка
+     */
+    static bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Записывает отрезок
+     * @param category Категория (строковый литерал)
+     * @param name Имя (строковый литерал)
+     * @param begin Начало отрезка
+     * @param end Конец отрезка
+     */
+    static void record(const char* category, const char* name,
+        std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+
+    /**
+     * @brief Записывает мгновенное событие
+     * @param category Категория (строковый литерал)
+     * @param name Имя (строковый литерал)
+     */
+    static void instant(const char* category, const char* name);
+
+    /**
+     * @brief Задает имя текущего потока в трассе
+     * @param name Имя (строковый литерал)
+     */
+    static void setThreadName(const char* name);
+
+    /**
+     * @brief Возвращает количество событий, записанных с начала трассировки
+     * @note Больше CAPACITY - старые события перезаписаны
+     */
+    static uint64_t getRecorded() { return _next.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Возвращает номер текущего потока, выдавая его при первом обращении
+     */
+    static uint32_t threadId();
+
+    /**
+     * @brief Занимает слот кольцевого буфера и заполняет событие
+     * @param category Категория
+     * @param name Имя
+     * @param begin Начало
+     * @param duration Длительность
+     * @param isInstant Мгновенное событие
+     */
+    static void push(const char* category, const char* name, std::chrono::steady_clock::time_point begin,
+        uint64_t duration, bool isInstant);
+};
+
+/**
+ * @brief Отрезок трассировки от конструктора до деструктора
+ */
+class TraceScope {
+private:
+    const char* _category;                       /**< Категория */
+    const char* _name;                           /**< Имя */
+    bool _active;                                /**< Трассировка была включена на входе */
+    std::chrono::steady_clock::time_point _begin; /**< Начало отрезка */
+
+public:
+    TraceScope(const char* category, const char* name): _category(category), _name(name),
+        _active(Tracer::isEnabled()) {
+        if (_active) {
+            _begin = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~TraceScope() {
+        if (_active) {
+            Tracer::record(_category, _name, _begin, std::chrono::steady_clock::now());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define GREED_TRACE_CONCAT_INNER(a, b) a##b
+#define GREED_TRACE_CONCAT(a, b) GREED_TRACE_CONCAT_INNER(a, b)
+
+#ifdef GREED_TRACING
+/** Отрезок трассировки до конца текущего блока */
+#define GREED_TRACE_SCOPE(category, name) TraceScope GREED_TRACE_CONCAT(_traceScope, __LINE__)(category, name)
+/** Мгновенное событие трассировки */
+#define GREED_TRACE_INSTANT(category, name) \
+    do { if (Tracer::isEnabled()) Tracer::instant(category, name); } while (0)
+/** Имя текущего потока в трассе */
+#define GREED_TRACE_THREAD(name) Tracer::setThreadName(name)
+#else
+#define GREED_TRACE_SCOPE(category, name) do {} while (0)
+#define GREED_TRACE_INSTANT(category, name) do {} while (0)
+#define GREED_TRACE_THREAD(name) do {} while (0)
+#endif
+
+#endif
@@ -6,6 +6,7 @@
 #define CELL
 
 #include "core/Color.hpp"
+#include "core/CellType.hpp"
 #include "core/Directions.hpp"
 #include "model/Position.hpp"
 
@@ -17,14 +18,33 @@ class ICellInteractionVisitor;
  * 
  * Определяет общий интерфейс для клеток игрового поля.
  * Реализует паттерн "Посетитель" для двойной диспетчеризации.
+ * Кроме того, каждая клетка хранит плотный идентификатор типа,
+ * по которому движок выполняет диспетчеризацию без виртуальных вызовов
+ * и без dynamic_cast (см. InteractionHandler::stepOn).
  */
 class ICell {
+private:
+    CellType _type; /**< Идентификатор типа клетки */
+
+protected:
+    /**
+     * @brief Конструктор базового класса
+     * @param type Идентификатор типа конкретной клетки
+     */
+    explicit ICell(CellType type): _type(type) {}
+
 public:
     /**
      * @brief Виртуальный деструктор
      */
     virtual ~ICell() = default;
 
+    /**
+     * @brief Возвращает идентификатор типа клетки
+     * @return Тип клетки
+     */
+    CellType getType() const { return _type; }
+
     /**
      * @brief Проверяет доступность клетки
      * @return true если клетка доступна для перемещения, false в противном случае
@@ -48,9 +68,10 @@ public:
     /**
      * @brief Принимает посетителя для обработки столкновения
      * @param visitor Посетитель для взаимодействия
+     * @param position Позиция клетки
      * @return Результат столкновения (например, изменение счета)
      */
-    virtual int acceptInteractionColission(ICellInteractionVisitor& visitor) = 0;
+    virtual int acceptInteractionColission(ICellInteractionVisitor& visitor, const Position& position) = 0;
     
     /**
      * @brief Принимает посетителя для обработки наступания
@@ -26,9 +26,10 @@ public:
     /**
      * @brief Обрабатывает столкновение с базовой клеткой
      * @param cell Ссылка на базовую клетку
+     * @param position Позиция клетки
      * @return Результат столкновения (например, изменение счета)
      */
-    virtual int collideWithBasicCell(BasicCell& cell) = 0;
+    virtual int collideWithBasicCell(BasicCell& cell, const Position& position) = 0;
     
     /**
      * @brief Обрабатывает наступание на базовую клетку
@@ -48,9 +49,10 @@ public:
     /**
      * @brief Обрабатывает столкновение с клеткой-телепортом
      * @param cell Ссылка на клетку-телепорт
+     * @param position Позиция клетки
      * @return Результат столкновения
      */
-    virtual int collideWithTeleportCell(TeleportCell& cell) = 0;
+    virtual int collideWithTeleportCell(TeleportCell& cell, const Position& position) = 0;
     
     /**
      * @brief Обрабатывает наступание на клетку-телепорт
@@ -62,9 +64,10 @@ public:
     /**
      * @brief Обрабатывает столкновение с клеткой-бомбой
      * @param cell Ссылка на клетку-бомбу
+     * @param position Позиция клетки
      * @return Результат столкновения
      */
-    virtual int collideWithBombCell(BombCell& cell) = 0;
+    virtual int collideWithBombCell(BombCell& cell, const Position& position) = 0;
     
     /**
      * @brief Обрабатывает наступание на клетку-бомбу
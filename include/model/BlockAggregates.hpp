@@ -0,0 +1,116 @@
+/**
+ * @file BlockAggregates.hpp
+ * @brief Заголовочный файл, содержащий объявление класса BlockAggregates
+ */
+#ifndef BLOCKAGGREGATES
+#define BLOCKAGGREGATES
+
+#include "interfaces/ICell.hpp"
+#include "model/Position.hpp"
+#include <vector>
+
+class Grid;
+
+/**
+ * @brief Сводка по квадратному блоку поля
+ */
+struct BlockStats {
+    long long initialValue;   /**< Сумма значений базовых клеток при построении */
+    long long remainingValue; /**< Сумма значений оставшихся базовых клеток */
+    long long bombsLeft;      /**< Количество оставшихся бомб */
+    long long cellsLeft;      /**< Количество оставшихся клеток */
+};
+
+/**
+ * @brief Уменьшенная сводка поля для миникарты
+ *
+ * Делит поле на не более чем MAX_BLOCKS x MAX_BLOCKS квадратных блоков и
+ * хранит для каждого оставшуюся сумму значений и число бомб. Сводка
+ * строится один раз при начале игры, а затем обновляется по каждой
+ * израсходованной клетке, поэтому ход стоит O(израсходованных клеток)
+ * без повторного обхода поля.
+ */
+class BlockAggregates {
+private:
+    int _blockSize;                /**< Сторона блока в клетках */
+    int _blocksX;                  /**< Количество блоков по горизонтали */
+    int _blocksY;                  /**< Количество блоков по вертикали */
+    long long _bombsLeft;          /**< Общее количество оставшихся бомб */
+    std::vector<BlockStats> _blocks; /**< Блоки (построчно) */
+    std::vector<int> _dirty;       /**< Индексы блоков, измененных с последней отрисовки */
+    std::vector<char> _isDirty;    /**< Флаги присутствия блока в _dirty */
+
+public:
+    static const int MAX_BLOCKS = 32;        /**< Наибольшее количество блоков по стороне */
+    static const int ESTIMATED_CELL_VALUE = 3; /**< Оценка значения клетки для еще не созданных частей поля */
+
+    /**
+     * @brief Конструктор пустой сводки
+     */
+    BlockAggregates();
+
+    /**
+     * @brief Строит сводку по полю
+     * @param grid Игровое поле
+     * @note Плотное поле обходится один раз; для поля из фрагментов
+     * начальные суммы оцениваются по частотам генератора, чтобы не
+     * создавать все фрагменты
+     */
+    void build(const Grid& grid);
+
+    /**
+     * @brief Учитывает израсходованную клетку
+     * @param position Позиция клетки
+     * @param type Тип клетки
+     * @param value Значение клетки (для базовой клетки)
+     */
+    void consume(const Position& position, CellType type, int value);
+
+    /**
+     * @brief Возвращает сводку блока
+     * @param blockX Столбец блока
+     * @param blockY Строка блока
+     * @return Ссылка на сводку
+     */
+    const BlockStats& at(int blockX, int blockY) const;
+
+    /**
+     * @brief Возвращает блок, содержащий клетку
+     * @param position Позиция клетки
+     * @return Столбец (X) и строка (Y) блока
+     */
+    Position blockOf(const Position& position) const;
+
+    /**
+     * @brief Возвращает блоки, измененные с последнего вызова clearDirty
+     * @return Линейные индексы блоков
+     */
+    const std::vector<int>& getDirtyBlocks() const { return _dirty; }
+
+    /**
+     * @brief Сбрасывает список измененных блоков
+     */
+    void clearDirty();
+
+    /**
+     * @brief Возвращает общее количество оставшихся бомб
+     */
+    long long getBombsLeft() const { return _bombsLeft; }
+
+    /**
+     * @brief Возвращает сторону блока в клетках
+     */
+    int getBlockSize() const { return _blockSize; }
+
+    /**
+     * @brief Возвращает количество блоков по горизонтали
+     */
+    int getBlocksX() const { return _blocksX; }
+
+    /**
+     * @brief Возвращает количество блоков по вертикали
+     */
+    int getBlocksY() const { return _blocksY; }
+};
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * @file BoardAnalyzer.hpp
+ * @brief Заголовочный файл, содержащий объявление класса BoardAnalyzer
+ */
+#ifndef BOARDANALYZER
+#define BOARDANALYZER
+
+#include "model/Grid.hpp"
+#include "model/Position.hpp"
+#include "core/Directions.hpp"
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Сводка по графу телепортов поля
+ */
+struct TeleportSummary {
+    int teleports = 0;          /**< Количество доступных телепортов */
+    int targetingStart = 0;     /**< Телепорты, ведущие на стартовую клетку */
+    int targetingBomb = 0;      /**< Телепорты, ведущие на бомбу */
+    int targetingTeleport = 0;  /**< Телепорты, ведущие на другой телепорт (цепочки) */
+    int chainsToBomb = 0;       /**< Телепорты, чья цепочка заканчивается бомбой */
+    int inCycles = 0;           /**< Телепорты, входящие в цикл */
+};
+
+/**
+ * @brief Результат анализа одного поля
+ */
+struct BoardReport {
+    int availableCells = 0;      /**< Доступные клетки поля */
+    int bombs = 0;               /**< Доступные бомбы */
+    int reachableCells = 0;      /**< Клетки, достижимые со стартовой позиции */
+    int deadCells = 0;           /**< Доступные, но недостижимые клетки */
+    double meanBranching = 0.0;  /**< Среднее число допустимых ходов из достижимых клеток */
+    TeleportSummary teleports;   /**< Сводка по телепортам */
+    int greedyScore = 0;         /**< Счет жадного прохождения */
+    int greedyMoves = 0;         /**< Количество ходов жадного прохождения */
+    std::vector<uint8_t> reachable; /**< Флаги достижимости клеток (построчно) */
+};
+
+/**
+ * @brief Анализатор качества игрового поля
+ *
+ * Строит компактный снимок поля и оценивает его играбельность:
+ * достижимость клеток, ветвление, структуру телепортов и результат
+ * быстрого жадного прохождения. Один экземпляр не потокобезопасен,
+ * для параллельного анализа используется analyzeBoards.
+ */
+class BoardAnalyzer {
+private:
+    /**
+     * @brief Тип клетки в снимке поля
+     */
+    enum CellKind : uint8_t { BASIC, TELEPORT, BOMB };
+
+    /**
+     * @brief Результат столкновения с клеткой при симуляции
+     */
+    enum Collision { BLOCKED, PASSED, STOPPED, TELEPORTED };
+
+    int _width;                     /**< Ширина анализируемого поля */
+    int _height;                    /**< Высота анализируемого поля */
+    std::vector<uint8_t> _kinds;    /**< Типы клеток */
+    std::vector<uint8_t> _values;   /**< Значения базовых клеток */
+    std::vector<int> _targets;      /**< Индексы целей телепортов (-1 для прочих клеток) */
+    std::vector<uint8_t> _available; /**< Доступность клеток (изменяется симуляцией) */
+    std::vector<int> _undo;         /**< Индексы клеток, измененных пробным ходом */
+    std::vector<int> _queue;        /**< Очередь обхода в ширину */
+    std::vector<int> _chain;        /**< Буфер для разбора цепочек телепортов */
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     */
+    BoardAnalyzer();
+
+    /**
+     * @brief Анализирует поле со стартом в центре (как в GameModel)
+     * @param grid Анализируемое поле
+     * @return Отчет о качестве поля
+     */
+    BoardReport analyze(const Grid& grid);
+
+    /**
+     * @brief Анализирует поле с заданной стартовой позиции
+     * @param grid Анализируемое поле
+     * @param start Стартовая позиция игрока
+     * @return Отчет о качестве поля
+     */
+    BoardReport analyze(const Grid& grid, const Position& start);
+
+    /**
+     * @brief Параллельно анализирует набор полей
+     * @param grids Поля для анализа
+     * @param threadCount Количество потоков (0 - по числу ядер)
+     * @return Отчеты в порядке входных полей
+     */
+    static std::vector<BoardReport> analyzeBoards(const std::vector<const Grid*>& grids, unsigned int threadCount = 0);
+
+private:
+    /**
+     * @brief Строит снимок поля
+     * @param grid Исходное поле
+     */
+    void takeSnapshot(const Grid& grid);
+
+    /**
+     * @brief Возвращает индекс клетки по координатам или -1 вне поля
+     */
+    int indexOf(int x, int y) const;
+
+    /**
+     * @brief Находит клетку приземления хода без учета расходования клеток
+     * @param from Индекс текущей клетки
+     * @param direction Направление хода
+     * @return Индекс клетки приземления или -1 если ход недопустим
+     */
+    int staticLanding(int from, Direction direction);
+
+    /**
+     * @brief Обходит цепочку активных телепортов до первой клетки, не являющейся активным телепортом
+     * @param index Индекс первой клетки цепочки
+     * @return Индекс итоговой клетки или -1 при цикле или выходе за поле
+     * @note Пройденные телепорты остаются в _chain
+     */
+    int followTeleports(int index);
+
+    /**
+     * @brief Находит клетку приземления после телепортации без учета расходования клеток
+     * @param tpTarget Индекс цели телепорта
+     * @return Индекс итоговой клетки или -1 если приземление невозможно
+     */
+    int staticTeleportLanding(int tpTarget);
+
+    /**
+     * @brief Симулирует перемещение по цепочке телепортов по правилам InteractionHandler
+     * @param tpTarget Индекс цели первого телепорта
+     * @param score Счет (изменяется)
+     * @param player Индекс клетки игрока (изменяется)
+     * @return Результат столкновения с итоговой клеткой
+     */
+    Collision teleportTo(int tpTarget, int& score, int& player);
+
+    /**
+     * @brief Симулирует столкновение с клеткой по правилам InteractionHandler
+     * @param index Индекс клетки
+     * @param score Счет (изменяется)
+     * @param player Индекс клетки игрока (изменяется)
+     * @return Результат столкновения
+     */
+    Collision collide(int index, int& score, int& player);
+
+    /**
+     * @brief Симулирует ход по правилам GameModel::makeMove
+     * @param direction Направление хода
+     * @param score Счет (изменяется)
+     * @param player Индекс клетки игрока (изменяется)
+     * @return true если игра продолжается после хода
+     */
+    bool simulateMove(Direction direction, int& score, int& player);
+
+    /**
+     * @brief Помечает клетку израсходованной с записью в журнал отката
+     */
+    void consume(int index);
+
+    /**
+     * @brief Откатывает изменения доступности, сделанные пробным ходом
+     */
+    void rollback();
+
+    /**
+     * @brief Вычисляет множество достижимых клеток и ветвление
+     */
+    void computeReachability(int start, BoardReport& report);
+
+    /**
+     * @brief Собирает сводку по телепортам
+     */
+    void summarizeTeleports(int start, BoardReport& report);
+
+    /**
+     * @brief Выполняет жадное прохождение поля
+     */
+    void greedyPlayout(int start, BoardReport& report);
+};
+
+#endif
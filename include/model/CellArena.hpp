@@ -0,0 +1,105 @@
+/**
+ * @file CellArena.hpp
+ * @brief Заголовочный файл, содержащий объявление класса CellArena
+ */
+#ifndef CELLARENA
+#define CELLARENA
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Монотонная арена для клеток поля
+ *
+ * Размещает клетки подряд в больших блоках памяти вместо отдельного
+ * new/delete на каждую клетку. Память освобождается целиком, а при
+ * сбросе блоки сохраняются и переиспользуются следующим полем,
+ * поэтому новая игра того же размера не выполняет ни одного выделения.
+ *
+ * @note Арена не вызывает деструкторы: владелец объектов разрушает их
+ *       сам перед reset() или release()
+ */
+class CellArena {
+private:
+    /**
+     * @brief Блок памяти арены
+     */
+    struct Block {
+        std::unique_ptr<std::max_align_t[]> data; /**< Память блока */
+        size_t size;                              /**< Размер блока в байтах */
+    };
+
+    std::vector<Block> _blocks; /**< Выделенные блоки */
+    size_t _current;            /**< Индекс текущего блока */
+    size_t _used;               /**< Занято байт в текущем блоке */
+    size_t _blockSize;          /**< Минимальный размер нового блока */
+
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024; /**< Размер блока по умолчанию */
+
+    /**
+     * @brief Конструктор пустой арены
+     * @param blockSize Минимальный размер блока в байтах
+     */
+    explicit CellArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    CellArena(const CellArena&) = delete;
+    CellArena& operator=(const CellArena&) = delete;
+    CellArena(CellArena&&) = default;
+    CellArena& operator=(CellArena&&) = default;
+
+    /**
+     * @brief Создает объект в арене
+     * @param args Аргументы конструктора
+     * @return Указатель на созданный объект
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Выделяет выровненный участок памяти
+     * @param size Размер в байтах
+     * @param alignment Выравнивание
+     * @return Указатель на участок
+     * @note Участок непрерывен, поэтому в него можно размещать объекты
+     *       с фиксированным шагом (в том числе из нескольких потоков)
+     */
+    void* allocate(size_t size, size_t alignment);
+
+    /**
+     * @brief Гарантирует непрерывное свободное место заданного размера
+     * @param bytes Требуемый объем в байтах
+     * @note Вызывается перед заполнением поля, чтобы все клетки попали в один блок
+     */
+    void reserve(size_t bytes);
+
+    /**
+     * @brief Сбрасывает арену, сохраняя блоки для повторного использования
+     */
+    void reset();
+
+    /**
+     * @brief Освобождает всю память арены
+     */
+    void release();
+
+    /**
+     * @brief Возвращает суммарный размер выделенных блоков
+     * @return Объем памяти в байтах
+     */
+    size_t capacity() const;
+
+private:
+    /**
+     * @brief Добавляет блок в конец и делает его текущим
+     * @param size Минимальный размер блока
+     */
+    void addBlock(size_t size);
+};
+
+#endif
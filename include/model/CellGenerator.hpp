@@ -6,20 +6,36 @@
 #define CELLGENERATOR
 
 #include "interfaces/ICell.hpp"
+#include "model/CellArena.hpp"
 #include "core/Color.hpp"
+#include <cstddef>
 #include <vector>
 
 /**
  * @brief Генератор клеток для игрового поля
  * 
  * Отвечает за создание различных типов клеток и генерацию случайных сеток.
+ * Клетки размещаются в арене вызывающего и живут, пока жива арена.
+ * Случайные значения берутся из CounterRng, а значения и кандидаты в
+ * специальные клетки для целой строки вычисляет GenerationKernel.
+ *
+ * Большие поля генерируются полосами по BAND_ROWS строк на нескольких потоках.
+ * Квоты бомб и телепортов выделяются каждой полосе отдельно, а размер полос
+ * не зависит от числа потоков, поэтому поле определяется только зерном.
  */
 class CellGenerator {
+private:
+    unsigned int _threadCount; /**< Количество потоков генерации (0 - по числу ядер) */
+
 public:
+    static const int BAND_ROWS = 64;                  /**< Высота полосы параллельной генерации */
+    static const int PARALLEL_MIN_CELLS = 1 << 18;    /**< Размер поля, начиная с которого генерация параллельна */
+
     /**
-     * @brief Конструктор по умолчанию
+     * @brief Конструктор генератора
+     * @param threadCount Количество потоков генерации больших полей (0 - по числу ядер)
      */
-    CellGenerator() = default;
+    explicit CellGenerator(unsigned int threadCount = 0);
     
     /**
      * @brief Деструктор по умолчанию
@@ -30,30 +46,118 @@ public:
      * @brief Генерирует случайную сетку клеток
      * @param width Ширина сетки
      * @param height Высота сетки
+     * @param arena Арена, в которой размещаются клетки
      * @return Вектор указателей на созданные клетки
      */
-    std::vector<ICell*> generateRandomGrid(int width, int height);
+    std::vector<ICell*> generateRandomGrid(int width, int height, CellArena& arena);
+
+    /**
+     * @brief Генерирует воспроизводимую сетку клеток по зерну
+     * @param width Ширина сетки
+     * @param height Высота сетки
+     * @param seed Зерно генератора случайных чисел
+     * @param arena Арена, в которой размещаются клетки
+     * @return Вектор указателей на созданные клетки
+     * @note Одинаковое зерно и размеры дают одинаковое поле на любом процессоре
+     *       и при любом числе потоков. Не имеет общего состояния, поэтому
+     *       безопасен для вызова из разных потоков
+     */
+    std::vector<ICell*> generateRandomGrid(int width, int height, unsigned int seed, CellArena& arena);
+
+    /**
+     * @brief Генерирует один тайл поля
+     * @param tileX Номер тайла по горизонтали
+     * @param tileY Номер тайла по вертикали
+     * @param tileSize Размер стороны тайла в клетках
+     * @param width Ширина всего поля
+     * @param height Высота всего поля
+     * @param seed Зерно поля
+     * @param arena Арена, в которой размещаются клетки
+     * @return Клетки тайла построчно (крайние тайлы обрезаются по границе поля)
+     * @note Случайные значения берутся из CounterRng по координатам клетки на поле,
+     *       поэтому тайл зависит только от (seed, tileX, tileY) и может
+     *       генерироваться повторно в любом порядке. Квоты бомб и телепортов
+     *       считаются на тайл, а цели телепортов не выходят за его пределы
+     */
+    std::vector<ICell*> generateTile(int tileX, int tileY, int tileSize, int width, int height,
+                                     unsigned int seed, CellArena& arena) const;
 
     /**
      * @brief Создает базовую клетку
      * @param value Значение клетки
+     * @param arena Арена, в которой размещается клетка
      * @return Указатель на созданную базовую клетку
      */
-    ICell* createBasicCell(int value);
+    ICell* createBasicCell(int value, CellArena& arena);
     
     /**
      * @brief Создает случайную клетку
+     * @param arena Арена, в которой размещается клетка
      * @return Указатель на созданную клетку случайного типа
      */
-    ICell* createRandomCell();
+    ICell* createRandomCell(CellArena& arena);
 
 private:
+    /**
+     * @brief Потоки случайных значений, используемых при создании клетки
+     */
+    enum RollSlot {
+        ROLL_VALUE,     /**< Значение базовой клетки */
+        ROLL_BOMB,      /**< Решение о создании бомбы */
+        ROLL_TELEPORT,  /**< Решение о создании телепорта */
+        ROLL_TARGET_X,  /**< Координата X цели телепорта */
+        ROLL_TARGET_Y   /**< Координата Y цели телепорта */
+    };
+
+    /**
+     * @brief Оставшиеся квоты специальных клеток
+     */
+    struct CellQuota {
+        int bombsLeft;     /**< Сколько еще можно создать бомб */
+        int teleportsLeft; /**< Сколько еще можно создать телепортов */
+    };
+
+    /**
+     * @brief Прямоугольная область поля
+     */
+    struct Region {
+        int x0;     /**< Левый столбец */
+        int y0;     /**< Верхняя строка */
+        int width;  /**< Ширина */
+        int height; /**< Высота */
+    };
+
+    /**
+     * @brief Генерирует прямоугольную область поля
+     * @param region Генерируемая область
+     * @param targets Область, в которой выбираются цели телепортов
+     * @param width Ширина всего поля
+     * @param height Высота всего поля
+     * @param seed Зерно поля
+     * @param quota Квоты специальных клеток области
+     * @param slots Память под клетки области (шаг cellSlotSize())
+     * @param cells Указатели на клетки области построчно
+     */
+    void generateRegion(const Region& region, const Region& targets, int width, int height,
+                        unsigned int seed, CellQuota quota, unsigned char* slots, ICell** cells) const;
+
+    /**
+     * @brief Возвращает шаг размещения клеток в памяти
+     * @return Размер наибольшего типа клетки с учетом выравнивания
+     */
+    static size_t cellSlotSize();
+
+    /**
+     * @brief Возвращает выравнивание, подходящее для любого типа клетки
+     */
+    static size_t cellSlotAlignment();
+
     /**
      * @brief Получает цвет по значению клетки
      * @param value Значение клетки
      * @return Цвет для отображения клетки
      */
-    Color getColor(int value);
+    Color getColor(int value) const;
 };
 
 #endif
\ No newline at end of file
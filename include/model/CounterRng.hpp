@@ -0,0 +1,86 @@
+/**
+ * @file CounterRng.hpp
+ * @brief Заголовочный файл, содержащий объявление класса CounterRng
+ */
+#ifndef COUNTERRNG
+#define COUNTERRNG
+
+#include <cstdint>
+
+/**
+ * @brief Генератор случайных чисел на основе счетчика
+ *
+ * Не имеет состояния: значение для клетки (x, y) в потоке slot вычисляется
+ * хешированием, поэтому любое значение можно получить независимо от остальных
+ * и в любом порядке. Хеш использует только 32-битные операции, поэтому
+ * векторная реализация (см. GenerationKernel) дает в точности те же значения.
+ */
+class CounterRng {
+private:
+    uint32_t _key; /**< Ключ генератора (производный от зерна) */
+
+public:
+    /**
+     * @brief Конструктор генератора
+     * @param seed Зерно
+     */
+    explicit CounterRng(uint64_t seed): _key(static_cast<uint32_t>(mix(seed + 0x9E3779B97F4A7C15ull))) {}
+
+    /**
+     * @brief Возвращает ключ потока для строки поля
+     * @param y Номер строки
+     * @param slot Номер потока (назначение случайного значения)
+     * @return Ключ потока, передаваемый в at()
+     */
+    uint32_t stream(int y, int slot) const {
+        return hash(_key ^ hash(static_cast<uint32_t>(y) * 0x9E3779B9u +
+                                static_cast<uint32_t>(slot) * 0x85EBCA6Bu + 0x632BE5ABu));
+    }
+
+    /**
+     * @brief Возвращает значение потока для столбца
+     * @param stream Ключ потока строки
+     * @param x Номер столбца
+     * @return Псевдослучайное 32-битное значение
+     */
+    static uint32_t at(uint32_t stream, int x) {
+        return hash(stream ^ (static_cast<uint32_t>(x) * 0xC2B2AE35u));
+    }
+
+    /**
+     * @brief Приводит случайное значение к диапазону [0, range)
+     * @param value Случайное 32-битное значение
+     * @param range Размер диапазона
+     * @return Значение из диапазона
+     */
+    static int reduce(uint32_t value, int range) {
+        return static_cast<int>((static_cast<uint64_t>(value) * static_cast<uint32_t>(range)) >> 32);
+    }
+
+    /**
+     * @brief 32-битный хеш lowbias32
+     * @param x Входное значение
+     * @return Перемешанное значение
+     */
+    static uint32_t hash(uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15;
+        x *= 0x846CA68Bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    /**
+     * @brief Финализатор splitmix64
+     * @param z Входное значение
+     * @return Перемешанное значение
+     */
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif
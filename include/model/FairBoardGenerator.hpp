@@ -0,0 +1,92 @@
+/**
+ * @file FairBoardGenerator.hpp
+ * @brief Заголовочный файл, содержащий объявление класса FairBoardGenerator
+ */
+#ifndef FAIRBOARDGENERATOR
+#define FAIRBOARDGENERATOR
+
+#include "model/BoardAnalyzer.hpp"
+#include <chrono>
+
+/**
+ * @brief Требования к "честному" игровому полю
+ */
+struct BoardConstraints {
+    int minGreedyScore = 60;          /**< Минимальный счет жадного прохождения */
+    int minReachableCells = 0;        /**< Минимальное число достижимых клеток */
+    double minBombDensity = 0.0;      /**< Минимальная доля бомб среди клеток в игре */
+    double maxBombDensity = 1.0;      /**< Максимальная доля бомб среди клеток в игре */
+    double minTeleportDensity = 0.0;  /**< Минимальная доля телепортов среди клеток в игре */
+    double maxTeleportDensity = 1.0;  /**< Максимальная доля телепортов среди клеток в игре */
+    bool allowTeleportToBomb = false; /**< Разрешены ли цепочки телепортов, ведущие на бомбу */
+};
+
+/**
+ * @brief Результат поиска поля
+ */
+struct FairBoardResult {
+    unsigned int seed = 0;  /**< Зерно найденного поля (для Grid/GameModel) */
+    bool satisfied = false; /**< true если поле удовлетворяет всем требованиям */
+    int candidates = 0;     /**< Количество проверенных кандидатов */
+    BoardReport report;     /**< Отчет анализатора для найденного поля */
+};
+
+/**
+ * @brief Генератор полей с ограничениями
+ *
+ * Генерирует кандидатов через CellGenerator на пуле потоков, каждый кандидат
+ * получает собственное зерно из независимого потока, производного от базового зерна.
+ * Возвращается кандидат с наименьшим номером, прошедший проверку. Если за
+ * отведенное время подходящее поле не найдено, возвращается лучшее по счету
+ * жадного прохождения (при равном счете - с наименьшим номером).
+ *
+ * Результат детерминирован (не зависит от числа потоков и машины), только если
+ * поиск уложился в timeBudget: при истечении времени набор проверенных
+ * кандидатов зависит от скорости потоков.
+ */
+class FairBoardGenerator {
+private:
+    unsigned int _threadCount;              /**< Количество рабочих потоков */
+    int _maxCandidates;                     /**< Максимум проверяемых кандидатов */
+    std::chrono::milliseconds _timeBudget;  /**< Ограничение времени поиска */
+
+public:
+    /**
+     * @brief Конструктор генератора
+     * @param threadCount Количество потоков (0 - по числу ядер)
+     * @param maxCandidates Максимум проверяемых кандидатов
+     * @param timeBudget Ограничение времени поиска
+     */
+    FairBoardGenerator(unsigned int threadCount = 0, int maxCandidates = 4096,
+                       std::chrono::milliseconds timeBudget = std::chrono::milliseconds(40));
+
+    /**
+     * @brief Ищет поле, удовлетворяющее требованиям
+     * @param width Ширина поля
+     * @param height Высота поля
+     * @param seed Базовое зерно
+     * @param constraints Требования к полю
+     * @return Зерно найденного поля и его отчет
+     */
+    FairBoardResult generate(int width, int height, unsigned int seed, const BoardConstraints& constraints) const;
+
+    /**
+     * @brief Проверяет отчет анализатора на соответствие требованиям
+     * @param report Отчет анализатора
+     * @param constraints Требования к полю
+     * @return true если все требования выполнены
+     * @note Доли бомб и телепортов считаются от клеток в игре: доступных и стартовой
+     * (report.availableCells + 1), а не от всего поля
+     */
+    static bool satisfies(const BoardReport& report, const BoardConstraints& constraints);
+
+    /**
+     * @brief Вычисляет зерно кандидата из базового зерна
+     * @param seed Базовое зерно
+     * @param candidate Номер кандидата
+     * @return Зерно кандидата
+     */
+    static unsigned int candidateSeed(unsigned int seed, int candidate);
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include "model/Player.hpp"
 #include "model/Position.hpp"
 #include "model/InteractionHandler.hpp"
+#include "model/BlockAggregates.hpp"
 #include "interfaces/ICell.hpp"
 #include "model/cells/BasicCell.hpp"
 #include "model/cells/TeleportCell.hpp"
@@ -33,6 +34,9 @@ private:
     bool _gameOver;                            /**< Флаг завершения игры */
     std::vector<std::pair<bool, Position>> _availableMoves; /**< Доступные ходы (возможность + позиция) */
     InteractionHandler _interactionHandler;    /**< Обработчик взаимодействий */
+    BlockAggregates _blockAggregates;          /**< Сводка по блокам поля для миникарты */
+    bool _blockAggregatesBuilt;                /**< Сводка построена для текущего поля (дальше ее ведет InteractionHandler) */
+    Position _viewExtent;                      /**< Размер окна просмотра: тайлы в его пределах вокруг игрока не выгружаются */
 
 public:
     /**
@@ -41,6 +45,38 @@ public:
      * @param height Высота поля (по умолчанию 25)
      */
     GameModel(int width=25, int height=25);
+
+    /**
+     * @brief Конструктор модели игры с воспроизводимым полем
+     * @param width Ширина поля
+     * @param height Высота поля
+     * @param seed Зерно генератора поля
+     */
+    GameModel(int width, int height, unsigned int seed);
+
+    /**
+     * @brief Конструктор модели игры из сохраненного состояния
+     * @param width Ширина поля
+     * @param height Высота поля
+     * @param cellValues Значения клеток
+     * @param cellColors Цвета клеток
+     * @param cellAvailable Флаги доступности клеток
+     * @param cellTypes Типы клеток
+     * @param teleportTargetsX X-координаты целей телепортов
+     * @param teleportTargetsY Y-координаты целей телепортов
+     * @param playerPos Позиция игрока
+     * @param score Начальный счет
+     * @note В отличие от initializeGameFromState() не генерирует случайное поле перед восстановлением
+     */
+    GameModel(int width, int height,
+              const std::vector<int>& cellValues,
+              const std::vector<int>& cellColors,
+              const std::vector<int>& cellAvailable,
+              const std::vector<int>& cellTypes,
+              const std::vector<int>& teleportTargetsX,
+              const std::vector<int>& teleportTargetsY,
+              const Position& playerPos,
+              int score);
     
     /**
      * @brief Деструктор по умолчанию
@@ -54,6 +90,8 @@ public:
 
     /**
      * @brief Инициализирует новую игру
+     * @note Сводка по блокам строится один раз на поле: повторный вызов (конструктор, затем
+     * GameController::startGame) не обходит поле заново
      */
     void initializeGame();
     
@@ -132,6 +170,21 @@ public:
      */
     std::vector<std::pair<bool, Position>>& getAvailableMoves();
 
+    /**
+     * @brief Возвращает сводку по блокам поля
+     * @return Ссылка на сводку (обновляется по мере расходования клеток)
+     */
+    BlockAggregates& getBlockAggregates();
+
+    /**
+     * @brief Сообщает модели размер окна просмотра
+     * @param columns Ширина окна в клетках
+     * @param rows Высота окна в клетках
+     * @note Окно всегда содержит игрока, поэтому при сжатии поля сохраняются
+     *       тайлы на таком расстоянии от него (но не меньше тайла)
+     */
+    void setViewExtent(int columns, int rows);
+
 private:
     /**
      * @brief Обновляет состояние игры после хода
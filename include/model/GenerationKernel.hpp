@@ -0,0 +1,76 @@
+/**
+ * @file GenerationKernel.hpp
+ * @brief Заголовочный файл, содержащий объявление класса GenerationKernel
+ */
+#ifndef GENERATIONKERNEL
+#define GENERATIONKERNEL
+
+#include <cstdint>
+
+/**
+ * @brief Параметры строки поля для ядра генерации
+ */
+struct GenerationRow {
+    uint32_t valueStream;    /**< Ключ потока значений клеток (CounterRng::stream) */
+    uint32_t bombStream;     /**< Ключ потока решений о бомбах */
+    uint32_t teleportStream; /**< Ключ потока решений о телепортах */
+    float centerX;           /**< Координата X центра поля */
+    float dy2;               /**< Квадрат расстояния строки до центра по вертикали */
+    float bandLimits[3];     /**< Пороги квадрата расстояния до центра (по убыванию) */
+    int x0;                  /**< Первый столбец */
+    int count;               /**< Количество клеток */
+};
+
+/**
+ * @brief Векторное ядро генерации клеток
+ *
+ * Для каждой клетки строки вычисляет полосу удаленности от центра, значение
+ * клетки и признаки кандидата в бомбу/телепорт, упаковывая их в один байт.
+ * Реализации AVX2 (8 клеток за итерацию), SSE2 (4 клетки) и скалярная
+ * выбираются во время выполнения и дают побитово одинаковый результат.
+ */
+class GenerationKernel {
+public:
+    /**
+     * @brief Набор инструкций реализации
+     */
+    enum Isa {
+        SCALAR, /**< Скалярная реализация */
+        SSE2,   /**< 128-битная реализация */
+        AVX2    /**< 256-битная реализация */
+    };
+
+    static const uint8_t VALUE_MASK = 0x07;    /**< Биты значения базовой клетки (1..5) */
+    static const uint8_t BOMB_FLAG = 0x08;     /**< Клетка - кандидат в бомбу */
+    static const uint8_t TELEPORT_FLAG = 0x10; /**< Клетка - кандидат в телепорт */
+
+    /**
+     * @brief Заполняет строку наилучшей доступной реализацией
+     * @param row Параметры строки
+     * @param out Выходной буфер из row.count байт
+     */
+    static void fillRow(const GenerationRow& row, uint8_t* out);
+
+    /**
+     * @brief Заполняет строку заданной реализацией
+     * @param row Параметры строки
+     * @param out Выходной буфер из row.count байт
+     * @param isa Реализация (неподдерживаемая процессором заменяется наилучшей доступной)
+     */
+    static void fillRow(const GenerationRow& row, uint8_t* out, Isa isa);
+
+    /**
+     * @brief Определяет наилучшую реализацию для текущего процессора
+     * @return Набор инструкций
+     */
+    static Isa detectIsa();
+
+    /**
+     * @brief Возвращает название реализации
+     * @param isa Набор инструкций
+     * @return Строка с названием
+     */
+    static const char* isaName(Isa isa);
+};
+
+#endif
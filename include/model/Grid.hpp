@@ -6,9 +6,15 @@
 #define GRID
 
 #include "core/Color.hpp"
+#include "model/CellArena.hpp"
 #include "model/CellGenerator.hpp"
 #include "interfaces/ICell.hpp"
 #include "model/Position.hpp"
+#include "model/TeleportTable.hpp"
+#include "model/cells/BasicCell.hpp"
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 /**
@@ -16,13 +22,44 @@
  * 
  * Управляет сеткой клеток, предоставляет доступ к клеткам по позициям
  * и отвечает за инициализацию и восстановление состояния поля.
+ * Клетки размещаются в собственной арене поля и освобождаются вместе с ней.
+ *
+ * Поля больше CHUNKED_THRESHOLD клеток хранятся разреженно: поле делится
+ * на тайлы TILE_SIZE x TILE_SIZE, которые генерируются при первом обращении.
+ * Нетронутые игрой тайлы при превышении лимита выгружаются (они генерируются
+ * заново из зерна), а полностью израсходованные заменяются общей пустой клеткой,
+ * поэтому память растет с исследованной областью, а не с размером поля.
  */
 class Grid {
+public:
+    static const int TILE_SIZE = 64;                       /**< Сторона тайла разреженного поля */
+    static const long long CHUNKED_THRESHOLD = 1ll << 24;  /**< Число клеток, начиная с которого поле хранится тайлами */
+    static const size_t MAX_RESIDENT_TILES = 1024;         /**< Число тайлов в памяти, после которого модель вызывает сжатие */
+    static const size_t COMPACT_TARGET_TILES = MAX_RESIDENT_TILES / 4 * 3; /**< Нижняя граница: сжатие выгружает нетронутые тайлы до этого числа */
+
 private:
+    /**
+     * @brief Тайл разреженного поля
+     */
+    struct Tile {
+        CellArena arena;            /**< Арена клеток тайла */
+        std::vector<ICell*> cells;  /**< Клетки тайла построчно */
+        int width;                  /**< Ширина тайла (крайние тайлы уже) */
+    };
+
+    CellArena _arena;           /**< Арена, владеющая памятью клеток */
     std::vector<ICell*> _cells; /**< Вектор клеток поля (линейное представление) */
     int _width;                 /**< Ширина поля */
     int _height;                /**< Высота поля */
     CellGenerator _generator;   /**< Генератор клеток */
+    mutable TeleportTable _teleports; /**< Таблица итоговых назначений телепортов */
+
+    bool _chunked;              /**< Флаг разреженного хранения */
+    unsigned int _seed;         /**< Зерно поля (для генерации тайлов) */
+    mutable std::unordered_map<long long, std::unique_ptr<Tile>> _tiles; /**< Тайлы в памяти по номеру */
+    std::unordered_set<long long> _consumedTiles; /**< Полностью израсходованные тайлы */
+    mutable BasicCell _consumedCell; /**< Общая пустая клетка для израсходованных тайлов */
+    size_t _compactRetryAt;     /**< Число тайлов, после которого повторяется сжатие, не опустившее поле ниже лимита */
 
 public:
     /**
@@ -31,6 +68,34 @@ public:
      * @param height Высота поля
      */
     Grid(int width, int height);
+
+    /**
+     * @brief Конструктор поля с заданным зерном генерации
+     * @param width Ширина поля
+     * @param height Высота поля
+     * @param seed Зерно генератора клеток
+     */
+    Grid(int width, int height, unsigned int seed);
+
+    /**
+     * @brief Конструктор поля из сохраненного состояния
+     * @param width Ширина поля
+     * @param height Высота поля
+     * @param cellValues Значения клеток
+     * @param cellColors Цвета клеток
+     * @param cellAvailable Флаги доступности клеток
+     * @param cellTypes Типы клеток
+     * @param teleportTargetsX X-координаты целей телепортов
+     * @param teleportTargetsY Y-координаты целей телепортов
+     * @note Случайное поле не генерируется: клетки сразу восстанавливаются через restoreState()
+     */
+    Grid(int width, int height,
+         const std::vector<int>& cellValues,
+         const std::vector<int>& cellColors,
+         const std::vector<int>& cellAvailable,
+         const std::vector<int>& cellTypes,
+         const std::vector<int>& teleportTargetsX,
+         const std::vector<int>& teleportTargetsY);
     
     /**
      * @brief Деструктор поля
@@ -42,6 +107,12 @@ public:
      * @brief Инициализирует поле случайными клетками
      */
     void initializeRandom();
+
+    /**
+     * @brief Инициализирует поле воспроизводимыми случайными клетками
+     * @param seed Зерно генератора клеток
+     */
+    void initializeRandom(unsigned int seed);
     
     /**
      * @brief Восстанавливает состояние поля из данных
@@ -83,8 +154,44 @@ public:
     /**
      * @brief Удаляет клетку с заданной позиции
      * @param position Позиция удаляемой клетки
+     * @note Для телепорта также обновляет таблицу назначений
      */
     void removeCell(const Position& position);
+
+    /**
+     * @brief Проверяет, хранится ли поле тайлами
+     * @return true для разреженного поля
+     */
+    bool isChunked() const;
+
+    /**
+     * @brief Возвращает число тайлов в памяти
+     * @return Количество сгенерированных тайлов (0 для плотного поля)
+     */
+    size_t getResidentTiles() const;
+
+    /**
+     * @brief Проверяет, пора ли сжимать разреженное поле
+     * @return true если тайлов больше MAX_RESIDENT_TILES и с прошлого
+     *         безрезультатного сжатия загружены новые тайлы
+     */
+    bool needsCompaction() const;
+
+    /**
+     * @brief Сжимает разреженное поле
+     * @param keepFrom Левый верхний угол области, тайлы которой не выгружаются
+     * @param keepTo Правый нижний угол этой области (включительно)
+     * @note Освобождает полностью израсходованные тайлы и выгружает нетронутые,
+     *       начиная с самых дальних от области, пока в памяти не останется
+     *       COMPACT_TARGET_TILES. Ссылки на клетки, полученные ранее, становятся недействительными
+     */
+    void compactTiles(const Position& keepFrom, const Position& keepTo);
+
+    /**
+     * @brief Возвращает таблицу назначений телепортов
+     * @return Константная ссылка на таблицу
+     */
+    const TeleportTable& getTeleports() const;
     
     /**
      * @brief Возвращает ширину поля
@@ -101,9 +208,41 @@ public:
 private:
     /**
      * @brief Очищает все клетки поля
-     * @note Освобождает память и очищает вектор
+     * @note Разрушает клетки и сбрасывает арену; память арены переиспользуется
      */
     void clearCells();
+
+    /**
+     * @brief Резервирует в арене место под все клетки поля
+     */
+    void reserveCells();
+
+    /**
+     * @brief Возвращает клетку по позиции без проверки границ
+     * @param position Позиция в пределах поля
+     * @return Ссылка на клетку (тайл генерируется при первом обращении)
+     */
+    ICell& cellAt(const Position& position) const;
+
+    /**
+     * @brief Возвращает тайл, генерируя его при необходимости
+     * @param tileX Номер тайла по горизонтали
+     * @param tileY Номер тайла по вертикали
+     * @return Ссылка на тайл
+     */
+    Tile& touchTile(int tileX, int tileY) const;
+
+    /**
+     * @brief Выгружает тайл из памяти
+     * @param key Номер тайла
+     * @param consumed true если тайл полностью израсходован
+     */
+    void dropTile(long long key, bool consumed);
+
+    /**
+     * @brief Возвращает число тайлов по горизонтали
+     */
+    int tilesX() const;
 };
 
 #endif
\ No newline at end of file
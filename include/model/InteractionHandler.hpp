@@ -16,13 +16,18 @@ class GameModel;
  * @brief Обработчик взаимодействий с клетками
  * 
  * Реализует паттерн "Посетитель" для обработки взаимодействий игрока
- * с различными типами клеток.
+ * с различными типами клеток. Сам движок обращается к обработчику напрямую:
+ * stepOn (наступание на клетку хода) и collideAt (столкновение с клеткой на
+ * пути прыжка или в конце цепочки телепортов) выбирают обработчик switch по
+ * CellType. Поэтому класс объявлен final и обработчики вызываются без таблицы
+ * виртуальных функций.
  */
-class InteractionHandler: public ICellInteractionVisitor {
+class InteractionHandler final: public ICellInteractionVisitor {
 private:
     GameModel& _model; /**< Ссылка на модель игры */
     std::vector<Position> _prevMoveAffectedElements; /**< Элементы, затронутые предыдущим ходом */
     Position _lastFinalPos; /**< Последняя конечная позиция после хода */
+    std::vector<Position> _jumpPath; /**< Переиспользуемый буфер клеток на пути прыжка */
 
 public:
     /**
@@ -39,10 +44,11 @@ public:
     /**
      * @brief Обрабатывает столкновение с базовой клеткой
      * @param cell Ссылка на базовую клетку
+     * @param cellPos Позиция клетки
      * @return Результат столкновения
      * @override
      */
-    int collideWithBasicCell(BasicCell& cell) override;
+    int collideWithBasicCell(BasicCell& cell, const Position& cellPos) override;
     
     /**
      * @brief Обрабатывает наступание на базовую клетку
@@ -64,10 +70,13 @@ public:
     /**
      * @brief Обрабатывает столкновение с клеткой-телепортом
      * @param cell Ссылка на клетку-телепорт
+     * @param cellPos Позиция клетки
      * @return Результат столкновения
+     * @note Цепочка телепортов разрешается по таблице поля без рекурсии;
+     *       зацикленная цепочка завершает игру
      * @override
      */
-    int collideWithTeleportCell(TeleportCell& cell) override;
+    int collideWithTeleportCell(TeleportCell& cell, const Position& cellPos) override;
     
     /**
      * @brief Обрабатывает наступание на клетку-телепорт
@@ -80,10 +89,11 @@ public:
     /**
      * @brief Обрабатывает столкновение с клеткой-бомбой
      * @param cell Ссылка на клетку-бомбу
+     * @param cellPos Позиция клетки
      * @return Результат столкновения
      * @override
      */
-    int collideWithBombCell(BombCell& cell) override;
+    int collideWithBombCell(BombCell& cell, const Position& cellPos) override;
     
     /**
      * @brief Обрабатывает наступание на клетку-бомбу
@@ -93,6 +103,13 @@ public:
      */
     void stepOnBombCell(BombCell& cell, const Position& cellPos) override;
 
+    /**
+     * @brief Обрабатывает наступание на клетку по позиции
+     * @param cellPos Позиция клетки
+     * @note Выбор обработчика выполняется по типу клетки без виртуального вызова
+     */
+    void stepOn(const Position& cellPos);
+
     /**
      * @brief Возвращает элементы, затронутые предыдущим ходом
      * @return Вектор позиций затронутых элементов
@@ -105,14 +122,31 @@ public:
      */
     Position getLastFinalPos() const { return _lastFinalPos; }
 
-private:
     /**
      * @brief Определяет клетки, через которые проходит движение
      * @param start Начальная позиция
      * @param finish Конечная позиция
-     * @return Вектор позиций клеток на пути движения
+     * @param jumpedOver Буфер, в который записываются позиции клеток на пути движения
+     * @note Буфер очищается, но его емкость сохраняется между ходами
+     */
+    void makeOver(const Position& start, const Position& finish, std::vector<Position>& jumpedOver) const;
+
+private:
+    /**
+     * @brief Обрабатывает столкновение с клеткой по позиции
+     * @param cellPos Позиция клетки
+     * @return Результат столкновения
+     * @note Выбор обработчика выполняется по типу клетки без виртуального вызова
+     */
+    int collideAt(const Position& cellPos);
+
+    /**
+     * @brief Перемещает игрока по цепочке телепортов, начиная с цели
+     * @param tpPos Цель первого телепорта
+     * @return Результат столкновения с итоговой клеткой цепочки
+     * @note Расходует все активные телепорты цепочки
      */
-    std::vector<Position> makeOver(const Position& start, const Position& finish) const;
+    int teleportTo(const Position& tpPos);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+ * @file TeleportTable.hpp
+ * @brief Заголовочный файл, содержащий объявление класса TeleportTable
+ */
+#ifndef TELEPORTTABLE
+#define TELEPORTTABLE
+
+#include "interfaces/ICell.hpp"
+#include "model/Position.hpp"
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Результат разрешения цепочки телепортов
+ */
+struct TeleportResolution {
+    Position destination; /**< Итоговая клетка цепочки (первая клетка, не являющаяся активным телепортом) */
+    bool cycle;           /**< true если цепочка зацикливается и не имеет итоговой клетки */
+};
+
+/**
+ * @brief Таблица итоговых назначений телепортов
+ *
+ * Для каждого активного телепорта хранит итоговую клетку его цепочки
+ * либо признак цикла. Таблица строится один раз при создании поля и
+ * обновляется при расходовании телепорта, поэтому разрешение цепочки
+ * выполняется за O(1) без рекурсии.
+ */
+class TeleportTable {
+private:
+    /**
+     * @brief Узел графа телепортов
+     */
+    struct Node {
+        Position target;                /**< Цель телепорта */
+        Position destination;           /**< Итоговая клетка цепочки */
+        bool cycle;                     /**< Флаг зацикленной цепочки */
+        bool resolved;                  /**< Флаг вычисленного назначения (только при построении) */
+        bool available;                 /**< Флаг активности телепорта */
+        std::vector<long long> sources; /**< Телепорты, ведущие на этот телепорт */
+    };
+
+    std::unordered_map<long long, Node> _nodes; /**< Телепорты по линейному индексу */
+    std::vector<long long> _pending;            /**< Добавленные, но еще не разрешенные телепорты */
+    std::vector<long long> _walk;               /**< Переиспользуемый стек обхода в markConsumed */
+    int _width;                                 /**< Ширина поля */
+    int _height;                                /**< Высота поля */
+
+public:
+    /**
+     * @brief Конструктор пустой таблицы
+     */
+    TeleportTable();
+
+    /**
+     * @brief Строит таблицу по клеткам поля
+     * @param cells Клетки поля (построчно)
+     * @param width Ширина поля
+     * @param height Высота поля
+     */
+    void build(const std::vector<ICell*>& cells, int width, int height);
+
+    /**
+     * @brief Очищает таблицу
+     */
+    void clear();
+
+    /**
+     * @brief Очищает таблицу и задает размеры поля
+     * @param width Ширина поля
+     * @param height Высота поля
+     */
+    void reset(int width, int height);
+
+    /**
+     * @brief Добавляет телепорт без разрешения цепочки
+     * @param position Позиция телепорта
+     * @param target Цель телепорта
+     * @param available Флаг активности телепорта
+     * @note Назначение вычисляется при следующем вызове resolvePending()
+     */
+    void add(const Position& position, const Position& target, bool available);
+
+    /**
+     * @brief Разрешает цепочки телепортов, добавленных через add()
+     * @note Уже разрешенные телепорты не должны вести на добавленные:
+     *       их назначения не пересчитываются
+     */
+    void resolvePending();
+
+    /**
+     * @brief Удаляет телепорт из таблицы
+     * @param position Позиция телепорта
+     * @note Ведущие на него телепорты должны удаляться вместе с ним
+     */
+    void erase(const Position& position);
+
+    /**
+     * @brief Проверяет, является ли клетка активным телепортом
+     * @param position Позиция клетки
+     * @return true если на позиции находится неизрасходованный телепорт
+     */
+    bool isActiveTeleport(const Position& position) const;
+
+    /**
+     * @brief Возвращает непосредственную цель телепорта
+     * @param position Позиция телепорта
+     * @return Позиция цели
+     */
+    Position getTarget(const Position& position) const;
+
+    /**
+     * @brief Разрешает перемещение на клетку с учетом цепочек телепортов
+     * @param position Клетка, на которую попадает игрок
+     * @return Сама клетка, если это не активный телепорт, иначе итог цепочки
+     */
+    TeleportResolution resolve(const Position& position) const;
+
+    /**
+     * @brief Помечает телепорт израсходованным и обновляет назначения
+     * @param position Позиция телепорта
+     * @note Все цепочки, проходившие через телепорт, теперь заканчиваются на нем
+     */
+    void markConsumed(const Position& position);
+
+private:
+    /**
+     * @brief Ищет телепорт по позиции
+     * @return Указатель на узел или nullptr, если на позиции нет телепорта
+     */
+    const Node* find(const Position& position) const;
+
+    /**
+     * @brief Переводит позицию в линейный индекс
+     * @return Индекс клетки или -1 для позиции вне поля
+     */
+    long long indexOf(const Position& position) const;
+};
+
+#endif
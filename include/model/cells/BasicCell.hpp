@@ -58,10 +58,11 @@ public:
     /**
      * @brief Принимает посетителя для обработки столкновения
      * @param visitor Посетитель для взаимодействия
+     * @param position Позиция клетки
      * @return Результат столкновения (значение клетки как очки)
      * @override
      */
-    int acceptInteractionColission(ICellInteractionVisitor& visitor) override;
+    int acceptInteractionColission(ICellInteractionVisitor& visitor, const Position& position) override;
     
     /**
      * @brief Принимает посетителя для обработки наступания
@@ -14,6 +14,8 @@
 #include "core/Directions.hpp"
 #include "interfaces/ICellRenderVisitor.hpp"
 #include "core/Color.hpp"
+#include "view/Viewport.hpp"
+#include "model/BlockAggregates.hpp"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -25,6 +27,8 @@
  * 
  * Реализует отрисовку всех элементов игры в терминале,
  * поддерживает цвета, позиционирование курсора и различные состояния отображения.
+ * Методы отрисовки поля не сбрасывают std::cout: кадр целиком выводится
+ * одной записью, когда вызывающий код сбрасывает поток в конце кадра.
  */
 class ConsoleRenderer: public ICellRenderVisitor{
 private:
@@ -35,19 +39,33 @@ private:
     std::string _teleportCellSymbol; /**< Символ для клетки-телепорта */
     std::string _bombCellSymbol;    /**< Символ для клетки-бомбы */
     Position _offset;               /**< Смещение для центрирования отображения */
+    Viewport* _viewport;            /**< Окно просмотра поля (не владеет) */
+    Position _minimapPlayerBlock;   /**< Блок миникарты, в котором игрок отрисован последним */
+    std::vector<std::vector<std::string>> _bigDigitGlyphs; /**< Крупные цифры по бокам поля (строки каждой цифры) */
+    int _bigDigitWidth;             /**< Наибольшая ширина строки крупной цифры */
+    const std::string _bigDigitColors[5] = {"\033[1;31m", "\033[1;32m", "\033[1;34m", "\033[1;33m", "\033[1;35m"}; /**< Цвета крупных цифр */
+    bool _sidePanel;                /**< Область крупных цифр слева от поля отдана панели показателей */
 
 public:
     /**
      * @brief Конструктор рендерера
      * @param offset Начальное смещение для отрисовки
+     * @param viewport Окно просмотра, определяющее видимую часть поля
      */
-    ConsoleRenderer(Position offset);
+    ConsoleRenderer(Position offset, Viewport* viewport);
     
     /**
      * @brief Деструктор по умолчанию
      */
     ~ConsoleRenderer() = default;
 
+    /**
+     * @brief Переносит отрисовку на новое смещение
+     * @param offset Новое смещение поля
+     * @note Таблицы цветов и символы сохраняются; после вызова нужна полная перерисовка
+     */
+    void relayout(Position offset);
+
     /**
      * @brief Отрисовывает базовую клетку
      * @param cell Ссылка на базовую клетку
@@ -79,6 +97,35 @@ public:
      */
     void drawStartingState(const Grid& grid);
     
+    /**
+     * @brief Сдвигает окно просмотра вслед за игроком
+     * @param grid Ссылка на игровое поле
+     * @param playerPos Позиция игрока
+     * @note Вертикальный сдвиг выполняется прокруткой области терминала (DECSTBM)
+     * с дорисовкой только открывшихся строк; горизонтальный сдвиг и прыжки
+     * дальше высоты окна перерисовывают окно целиком
+     * @return true если строки терминала были прокручены целиком и все, что
+     * выведено справа от окна в этих строках (миникарта), нужно перерисовать
+     */
+    bool followPlayer(const Grid& grid, const Position& playerPos);
+
+    /**
+     * @brief Отрисовывает миникарту целиком справа от поля
+     * @param blocks Сводка по блокам поля
+     * @param playerPos Позиция игрока
+     * @note Каждый символ "▀" показывает два блока по вертикали: цвет символа -
+     * верхний блок, цвет фона - нижний; цвет блока отражает долю оставшихся очков
+     */
+    void drawMinimap(BlockAggregates& blocks, const Position& playerPos);
+
+    /**
+     * @brief Перерисовывает только измененные блоки миникарты
+     * @param blocks Сводка по блокам поля
+     * @param playerPos Позиция игрока
+     * @note Стоимость пропорциональна числу блоков, затронутых ходом
+     */
+    void updateMinimap(BlockAggregates& blocks, const Position& playerPos);
+
     /**
      * @brief Отрисовывает игрока
      * @param playerPos Позиция игрока
@@ -147,12 +194,40 @@ public:
      */
     void drawScoreAtPosition(int score, const Position& pos) const;
 
+    /**
+     * @brief Заменяет строку управления под полем текстом
+     * @param text Текст без ESC-последовательностей, завершенный нулем (обрезается по ширине терминала)
+     * @note Исходная строка управления возвращается при полной перерисовке
+     */
+    void drawStatusLine(const char* text) const;
+
+    /**
+     * @brief Отдает область крупных цифр слева от поля под панель или возвращает цифры
+     * @param reserved true - при полной перерисовке цифры слева не рисуются
+     */
+    void reserveSidePanel(bool reserved);
+
+    /**
+     * @brief Отрисовывает панель текста слева от поля, у верхнего края
+     * @param lines Строки без ESC-последовательностей
+     * @param count Количество строк
+     * @param width Ширина панели (короткие строки дополняются пробелами)
+     * @return false если слева от поля или по высоте окна не хватает места
+     */
+    bool drawSidePanel(const char* const lines[], int count, int width) const;
+
 private:
     /**
      * @brief Инициализирует карту цветовых кодов
      * @note Заполняет карту ANSI-кодами для каждого цвета
      */
     void initializeColorCodes();
+
+    /**
+     * @brief Строит таблицу крупных цифр для боковых надписей
+     * @note Вызывается один раз; таблица переживает relayout()
+     */
+    void initializeGlyphs();
     
     /**
      * @brief Возвращает ANSI-код для указанного цвета
@@ -167,6 +242,44 @@ private:
      */
     void moveCursor(const Position& pos) const;
     
+    /**
+     * @brief Переводит клетку поля в позицию на экране
+     * @param cellPos Клетка поля
+     * @return Позиция на экране с учетом смещения и окна просмотра
+     */
+    Position toScreen(const Position& cellPos) const;
+
+    /**
+     * @brief Отрисовывает строку окна просмотра вместе с боковыми рамками
+     * @param grid Ссылка на игровое поле
+     * @param row Номер строки внутри окна
+     */
+    void drawWindowRow(const Grid& grid, int row);
+
+    /**
+     * @brief Отрисовывает символ миникарты, содержащий блок
+     * @param blocks Сводка по блокам поля
+     * @param block Блок (столбец, строка)
+     */
+    void drawMinimapCell(const BlockAggregates& blocks, const Position& block) const;
+
+    /**
+     * @brief Отрисовывает строку с количеством оставшихся бомб под миникартой
+     * @param blocks Сводка по блокам поля
+     */
+    void drawMinimapBombs(const BlockAggregates& blocks) const;
+
+    /**
+     * @brief Возвращает левый верхний угол миникарты на экране
+     */
+    Position minimapOrigin() const;
+
+    /**
+     * @brief Прокручивает строки поля на экране
+     * @param rows Количество строк (положительное - вверх, отрицательное - вниз)
+     */
+    void scrollWindow(int rows) const;
+
     /**
      * @brief Скрывает курсор терминала
      */
@@ -0,0 +1,75 @@
+/**
+ * @file CountingSink.hpp
+ * @brief Заголовочный файл, содержащий объявление класса CountingSink
+ */
+#ifndef COUNTINGSINK
+#define COUNTINGSINK
+
+#include <cstddef>
+#include <streambuf>
+
+/**
+ * @brief Пустой приемник вывода, считающий байты и записи
+ *
+ * Подставляется в std::cout вместо терминала при запуске без TTY.
+ * Вывод буферизуется как в обычном потоке, и каждый сброс буфера
+ * считается одной записью (аналог вызова write), после чего данные
+ * передаются в consume() и отбрасываются.
+ */
+class CountingSink : public std::streambuf {
+private:
+    static const size_t BUFFER_SIZE = 4096; /**< Размер буфера до сброса */
+
+    char _buffer[BUFFER_SIZE];  /**< Буфер вывода */
+    unsigned long long _bytes;  /**< Сброшено байт */
+    unsigned long long _writes; /**< Количество сбросов */
+
+public:
+    /**
+     * @brief Конструктор пустого приемника
+     */
+    CountingSink();
+
+    CountingSink(const CountingSink&) = delete;
+    CountingSink& operator=(const CountingSink&) = delete;
+
+    /**
+     * @brief Возвращает количество выведенных байт, включая еще не сброшенные
+     */
+    unsigned long long getBytes() const;
+
+    /**
+     * @brief Возвращает количество сбросов буфера
+     */
+    unsigned long long getWrites() const { return _writes; }
+
+protected:
+    /**
+     * @brief Сбрасывает заполненный буфер и принимает следующий символ
+     * @param ch Символ
+     * @return ch или not_eof при EOF
+     */
+    int_type overflow(int_type ch) override;
+
+    /**
+     * @brief Сбрасывает буфер (std::flush)
+     * @return 0
+     */
+    int sync() override;
+
+    /**
+     * @brief Принимает сброшенные байты
+     * @param data Байты
+     * @param length Количество байт
+     * @note Пустой приемник их отбрасывает; наследники могут разбирать вывод
+     */
+    virtual void consume(const char* data, size_t length);
+
+private:
+    /**
+     * @brief Учитывает содержимое буфера и очищает его
+     */
+    void drain();
+};
+
+#endif
@@ -9,10 +9,43 @@
 #include "model/Position.hpp"
 #include "view/ConsoleRenderer.hpp"
 #include "view/Settings.hpp"
+#include "view/Viewport.hpp"
+#include "view/ResizeWatcher.hpp"
+#include "view/TerminalGeometry.hpp"
+#include "view/LatencyMonitor.hpp"
+#include "view/RuntimeStats.hpp"
+#include "view/TerminalSink.hpp"
+#include "core/SpscQueue.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <string>
 
+/**
+ * @brief Запрос на отрисовку, передаваемый потоку отрисовки
+ */
+struct RenderRequest {
+    /**
+     * @brief Вид запроса
+     */
+    enum Kind {
+        MOVE,      /**< Ход выполнен: перерисовать затронутые клетки */
+        HIGHLIGHT, /**< Подсветить направление хода */
+        REFRESH,   /**< Полная перерисовка */
+        STOP       /**< Завершить поток отрисовки */
+    };
+
+    Kind kind = REFRESH;                      /**< Вид запроса */
+    Direction direction = Direction::NONE;    /**< Направление подсветки */
+    std::pair<bool, Position> moves[4];       /**< Доступные ходы на момент подсветки */
+    MoveTiming timing;                        /**< Моменты хода (для MOVE с клавиатуры) */
+};
+
 /**
  * @brief Основной класс представления игры
  * 
@@ -24,14 +57,83 @@ private:
     GameModel* _model;                    /**< Указатель на модель игры */
     std::unique_ptr<ConsoleRenderer> _renderer; /**< Умный указатель на рендерер */
     std::unique_ptr<Settings> _settings;        /**< Умный указатель на настройки */
+    std::unique_ptr<Viewport> _viewport;        /**< Окно просмотра поля (сохраняется между перерисовками) */
+    bool _showMinimap;                          /**< Флаг отображения миникарты (поле не помещается в терминал) */
+    Position _fieldOffset;                      /**< Смещение поля, по которому создан рендерер */
+    unsigned _layoutGeneration;                 /**< Версия размера терминала, для которой рассчитана раскладка */
+    std::unique_ptr<ResizeWatcher> _resizeWatcher; /**< Доставка SIGWINCH в основной цикл */
+
+    std::thread _renderThread;                  /**< Поток отрисовки */
+    bool _rendering;                            /**< Флаг работы потока отрисовки (меняет только поток управления) */
+    SpscQueue<RenderRequest, 64> _requests;     /**< Запросы от потока управления к потоку отрисовки */
+    std::mutex _modelMutex;                     /**< Защищает модель и экран между потоками */
+    std::vector<Position> _pendingCells;        /**< Клетки, затронутые ходами с последнего кадра (под _modelMutex) */
+    std::vector<std::pair<bool, Position>> _highlightMoves; /**< Буфер ходов для подсветки (поток отрисовки) */
+    bool _highlightShown;                       /**< На экране осталась подсветка из _highlightMoves (поток отрисовки) */
+    std::vector<std::chrono::steady_clock::time_point> _frameMoves; /**< Время чтения клавиш ходов текущего кадра (поток отрисовки) */
+    std::atomic<bool> _latencyOverlay;          /**< Показывать задержки ходов вместо строки управления */
+    std::atomic<bool> _statsOverlay;            /**< Показывать панель показателей вместо крупных цифр слева */
+    RuntimeStats _stats;                        /**< Показатели кадров и ходов (поток отрисовки) */
+    std::unique_ptr<TerminalSink> _terminalSink; /**< Счетчик вывода, подставленный в std::cout на время жизни представления */
+    std::streambuf* _previousOutput;            /**< Приемник std::cout до подстановки _terminalSink */
+    CountingSink* _output;                      /**< Приемник std::cout, считающий байты кадров */
+    std::mutex _wakeMutex;                      /**< Защищает счетчики запросов */
+    std::condition_variable _wake;              /**< Пробуждение потока отрисовки */
+    std::condition_variable _idle;              /**< Сигнал об отрисовке всех запросов */
+    unsigned long long _posted;                 /**< Отправлено запросов (под _wakeMutex) */
+    unsigned long long _presented;              /**< Отрисовано запросов (под _wakeMutex) */
+    unsigned long long _dropped;                /**< Запросов, не поместившихся в очередь (под _wakeMutex) */
 
     /**
      * @brief Обновляет рендерер
-     * @note Пересоздает рендерер с актуальными смещениями
+     * @note Подгоняет окно просмотра под терминал и переносит рендерер на актуальные смещения
      */
     void updateRenderer();
 
+    /**
+     * @brief Отрисовывает миникарту целиком, если она отображается
+     */
+    void renderMinimap();
+
+    /**
+     * @brief Полностью перерисовывает экран в текущем потоке
+     */
+    void refreshNow();
+
+    /**
+     * @brief Отрисовывает результат хода в текущем потоке
+     * @param affectedElements Клетки, затронутые ходом (или несколькими ходами)
+     */
+    void presentMove(const std::vector<Position>& affectedElements);
+
+    /**
+     * @brief Выводит задержки ходов в строку управления, если наложение включено
+     */
+    void renderLatencyOverlay();
+
+    /**
+     * @brief Выводит панель показателей слева от поля, если она включена
+     * @note Если слева нет места, показатели занимают строку управления (когда ее не заняли задержки)
+     */
+    void renderStatsOverlay();
+
+    /**
+     * @brief Передает запрос потоку отрисовки
+     * @param request Запрос
+     * @note При переполнении очереди следующий кадр становится полной перерисовкой
+     */
+    void post(const RenderRequest& request);
+
+    /**
+     * @brief Цикл потока отрисовки
+     * @note Забирает все накопившиеся запросы, объединяет их в один кадр и
+     * выводит его не чаще одного раза за FRAME_INTERVAL_MS
+     */
+    void renderLoop();
+
 public:
+    static const int FRAME_INTERVAL_MS = 16; /**< Наименьший интервал между кадрами потока отрисовки */
+
     /**
      * @brief Конструктор представления игры
      * @param model Указатель на модель игры
@@ -49,6 +151,38 @@ public:
      */
     void refresh();
     
+    /**
+     * @brief Запускает поток отрисовки
+     * @note После запуска renderMove, highlightMoveDirection и refresh только
+     * ставят запрос в очередь; изменять модель можно только под lockModel()
+     */
+    void startRendering();
+
+    /**
+     * @brief Отрисовывает оставшиеся запросы и останавливает поток отрисовки
+     */
+    void stopRendering();
+
+    /**
+     * @brief Ожидает отрисовки всех отправленных запросов
+     * @note После возврата поток управления может писать в терминал сам,
+     * пока не отправит новый запрос
+     */
+    void waitForIdle();
+
+    /**
+     * @brief Блокирует модель от чтения потоком отрисовки
+     * @return Захваченная блокировка
+     */
+    std::unique_lock<std::mutex> lockModel();
+
+    /**
+     * @brief Применяет изменение размера терминала, если оно устоялось
+     * @return true если экран был перерисован
+     * @note Вызывается из основного цикла контроллера вместо перерисовки в обработчике сигнала
+     */
+    bool handlePendingResize();
+
     /**
      * @brief Отображает информацию о смещении (для отладки)
      */
@@ -66,8 +200,21 @@ public:
     
     /**
      * @brief Рендерит ход игрока
+     * @param timing Моменты хода для замера задержки (пустые - ход не замеряется)
+     */
+    void renderMove(const MoveTiming& timing = MoveTiming());
+
+    /**
+     * @brief Включает или выключает наложение с задержками ходов
+     * @note Наложение занимает строку управления под полем
+     */
+    void toggleLatencyOverlay();
+
+    /**
+     * @brief Включает или выключает панель показателей (время хода и кадра, байты кадра, память)
+     * @note Панель занимает место крупных цифр слева от поля
      */
-    void renderMove();
+    void toggleStatsOverlay();
     
     /**
      * @brief Подсвечивает возможные направления движения
@@ -0,0 +1,104 @@
+/**
+ * @file LatencyMonitor.hpp
+ * @brief Заголовочный файл, содержащий объявление класса LatencyMonitor
+ */
+#ifndef LATENCYMONITOR
+#define LATENCYMONITOR
+
+#include "core/LatencyHistogram.hpp"
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Моменты прохождения хода от клавиши до экрана
+ */
+struct MoveTiming {
+    std::chrono::steady_clock::time_point readTime;    /**< Байты клавиши прочитаны из терминала */
+    std::chrono::steady_clock::time_point decodedTime; /**< Клавиша разобрана и передана контроллеру */
+    std::chrono::steady_clock::time_point appliedTime; /**< Ход применен к модели (GameModel::makeMove) */
+
+    /**
+     * @brief Проверяет, заполнены ли моменты
+     * @return true если ход пришел с клавиатуры, а не из кода
+     */
+    bool isSet() const { return readTime != std::chrono::steady_clock::time_point(); }
+};
+
+/**
+ * @brief Задержки хода по фазам
+ *
+ * Собирает гистограммы задержки от чтения клавиши до вывода кадра:
+ * разбор ввода, работа модели, ожидание кадра в потоке отрисовки,
+ * построение кадра, запись в терминал и полный путь. Фазы ввода и модели
+ * пишет поток управления, остальные - поток отрисовки; гистограммы общие
+ * для всех игр процесса. Время от прихода байт в терминал до их чтения
+ * не наблюдаемо и в фазу ввода не входит.
+ */
+class LatencyMonitor {
+public:
+    /**
+     * @brief Фаза пути клавиши до экрана
+     */
+    enum Phase {
+        INPUT,      /**< Чтение байт - разбор клавиши */
+        MODEL,      /**< Разбор клавиши - ход применен (с ожиданием блокировки модели) */
+        QUEUE,      /**< Ход применен - начало кадра (очередь и ограничение частоты кадров) */
+        BUILD,      /**< Начало кадра - кадр построен в буфере вывода */
+        WRITE,      /**< Кадр построен - кадр записан в терминал */
+        TOTAL,      /**< Чтение байт - кадр записан */
+        PHASE_COUNT /**< Количество фаз */
+    };
+
+private:
+    LatencyHistogram _phases[PHASE_COUNT]; /**< Гистограммы фаз */
+
+public:
+    /**
+     * @brief Возвращает общий монитор процесса
+     * @return Ссылка на монитор
+     */
+    static LatencyMonitor& instance();
+
+    /**
+     * @brief Возвращает имя фазы
+     * @param phase Фаза
+     */
+    static const char* phaseName(Phase phase);
+
+    /**
+     * @brief Добавляет задержку фазы
+     * @param phase Фаза
+     * @param from Начало
+     * @param to Конец (раньше начала - считается нулем)
+     */
+    void record(Phase phase, std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to);
+
+    /**
+     * @brief Возвращает гистограмму фазы
+     * @param phase Фаза
+     */
+    const LatencyHistogram& get(Phase phase) const { return _phases[phase]; }
+
+    /**
+     * @brief Обнуляет все фазы
+     */
+    void reset();
+
+    /**
+     * @brief Формирует строку для наложения на экран игры
+     * @param buffer Буфер строки (медиана и 99-й процентиль каждой фазы в миллисекундах)
+     * @param size Размер буфера
+     * @note Строка выводится на каждом кадре, поэтому формируется без выделения памяти
+     */
+    void summary(char* buffer, size_t size) const;
+
+    /**
+     * @brief Записывает сводку и гистограммы фаз в файл
+     * @param path Путь к файлу
+     * @return true если файл записан
+     */
+    bool dump(const std::string& path) const;
+};
+
+#endif
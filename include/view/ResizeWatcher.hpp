@@ -0,0 +1,65 @@
+/**
+ * @file ResizeWatcher.hpp
+ * @brief Заголовочный файл, содержащий объявление класса ResizeWatcher
+ */
+#ifndef RESIZEWATCHER
+#define RESIZEWATCHER
+
+#include <chrono>
+#include <signal.h>
+
+/**
+ * @brief Доставка SIGWINCH в основной цикл через self-pipe
+ *
+ * Обработчик сигнала только записывает байт в неблокирующий канал
+ * (write - async-signal-safe), а вся перерисовка выполняется в основном
+ * цикле. Серия сигналов при перетаскивании окна схлопывается: poll()
+ * сообщает об изменении один раз, когда размер не менялся SETTLE_MS.
+ * Одновременно может существовать только один наблюдатель.
+ */
+class ResizeWatcher {
+private:
+    int _readFd;                                    /**< Читающий конец канала */
+    int _writeFd;                                   /**< Пишущий конец канала (используется обработчиком) */
+    bool _pending;                                  /**< Получен сигнал, размер еще не устоялся */
+    std::chrono::steady_clock::time_point _lastSignal; /**< Время последнего сигнала */
+    struct sigaction _previousAction;               /**< Обработчик SIGWINCH до установки наблюдателя */
+
+public:
+    static const int SETTLE_MS = 60; /**< Время без новых сигналов, после которого размер считается устоявшимся */
+
+    /**
+     * @brief Создает канал и устанавливает обработчик SIGWINCH
+     * @throws std::runtime_error если канал не удалось создать
+     */
+    ResizeWatcher();
+
+    /**
+     * @brief Восстанавливает прежний обработчик и закрывает канал
+     */
+    ~ResizeWatcher();
+
+    ResizeWatcher(const ResizeWatcher&) = delete;
+    ResizeWatcher& operator=(const ResizeWatcher&) = delete;
+
+    /**
+     * @brief Забирает накопленные сигналы
+     * @return true ровно один раз на серию сигналов, после которой размер устоялся
+     * @note Вызывается из основного цикла; не блокируется
+     */
+    bool poll();
+
+    /**
+     * @brief Возвращает дескриптор канала для ожидания в select/poll
+     */
+    int getFd() const { return _readFd; }
+
+private:
+    /**
+     * @brief Обработчик SIGWINCH: записывает байт в канал
+     * @param sig Номер сигнала
+     */
+    static void onSignal(int sig);
+};
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file RuntimeStats.hpp
+ * @brief Заголовочный файл, содержащий объявление класса RuntimeStats
+ */
+#ifndef RUNTIMESTATS
+#define RUNTIMESTATS
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Текущие показатели игры для наложения на экран
+ *
+ * Хранит время последнего хода (от чтения клавиши до записанного кадра),
+ * байты и время последних кадров, темп ходов и память процесса. Кадры и
+ * ходы пишет поток отрисовки; память (куча malloc и RSS из /proc) читается
+ * не чаще раза в SAMPLE_INTERVAL_MS и только пока наложение показывается.
+ * Форматирование идет в буферы фиксированного размера без выделения памяти.
+ */
+class RuntimeStats {
+public:
+    static const int FRAME_WINDOW = 32;        /**< Кадров в скользящем среднем времени кадра */
+    static const int SAMPLE_INTERVAL_MS = 500; /**< Наименьший интервал между чтениями памяти и темпа */
+    static const int VALUE_COUNT = 6;          /**< Показателей в панели */
+    static const int LINE_COUNT = VALUE_COUNT + 1; /**< Строк в панели (с заголовком) */
+    static const int LINE_WIDTH = 18;          /**< Ширина строки панели в символах */
+    static const int LABEL_WIDTH = 7;          /**< Ширина подписи в строке панели */
+    static const int VALUE_SIZE = 24;          /**< Размер буфера одного значения (20 цифр long long, единицы и ноль) */
+    static const char* const LABELS[VALUE_COUNT]; /**< Подписи показателей */
+
+    /**
+     * @brief Строки панели
+     */
+    typedef char Lines[LINE_COUNT][LINE_WIDTH + 1];
+
+    /**
+     * @brief Значения показателей с единицами измерения
+     */
+    typedef char Values[VALUE_COUNT][VALUE_SIZE];
+
+private:
+    long long _lastMoveNs;                  /**< Время последнего хода (-1 - ходов не было) */
+    long long _lastFrameBytes;              /**< Байт последнего кадра (-1 - вывод не считается) */
+    long long _frameNs[FRAME_WINDOW];       /**< Время последних кадров */
+    int _frameCount;                        /**< Заполнено элементов _frameNs */
+    int _frameNext;                         /**< Следующий элемент _frameNs для записи */
+    long long _frameSum;                    /**< Сумма заполненных элементов _frameNs */
+    unsigned long long _moves;              /**< Ходов с начала игры */
+    unsigned long long _sampledMoves;       /**< Ходов на момент последнего чтения */
+    std::chrono::steady_clock::time_point _sampledAt; /**< Момент последнего чтения (пустой - не читалось) */
+    double _movesPerSecond;                 /**< Темп ходов между двумя последними чтениями */
+    long long _heapBytes;                   /**< Занято в куче malloc (-1 - недоступно) */
+    long long _residentBytes;               /**< Резидентная память процесса (-1 - недоступно) */
+
+public:
+    /**
+     * @brief Конструктор пустых показателей
+     */
+    RuntimeStats();
+
+    /**
+     * @brief Учитывает ход
+     * @param latencyNs Время от чтения клавиши до записанного кадра
+     */
+    void recordMove(long long latencyNs);
+
+    /**
+     * @brief Учитывает кадр
+     * @param frameNs Время от начала кадра до записи в терминал
+     * @param bytes Байт вывода кадра (-1 - вывод не считается)
+     */
+    void recordFrame(long long frameNs, long long bytes);
+
+    /**
+     * @brief Обновляет память и темп ходов, если прошло SAMPLE_INTERVAL_MS
+     * @param now Текущий момент
+     */
+    void sample(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Формирует значения показателей в порядке LABELS
+     * @param values Буферы значений
+     */
+    void values(Values& values) const;
+
+    /**
+     * @brief Формирует строки панели
+     * @param lines Буферы строк
+     */
+    void format(Lines& lines) const;
+
+    /**
+     * @brief Формирует однострочную сводку для строки управления
+     * @param buffer Буфер
+     * @param size Размер буфера
+     */
+    void formatLine(char* buffer, size_t size) const;
+
+    /**
+     * @brief Возвращает занятую память кучи malloc
+     * @return Байты (-1 если libc не сообщает)
+     */
+    static long long heapBytes();
+
+    /**
+     * @brief Возвращает резидентную память процесса
+     * @return Байты (-1 если /proc/self/statm недоступен)
+     */
+    static long long residentBytes();
+
+private:
+    /**
+     * @brief Возвращает среднее время последних кадров
+     * @return Наносекунды (-1 если кадров не было)
+     */
+    long long averageFrameNs() const;
+};
+
+#endif
@@ -41,11 +41,21 @@ public:
     
     /**
      * @brief Рассчитывает смещения для центрирования игрового поля
-     * @param gridWidth Ширина игрового поля
-     * @param gridHeight Высота игрового поля
+     * @param gridWidth Ширина отображаемой части поля
+     * @param gridHeight Высота отображаемой части поля
      * @return Позиция смещения для центрирования
      */
     Position calculateCenteringOffsets(int gridWidth, int gridHeight);
+
+    /**
+     * @brief Рассчитывает размер окна просмотра, помещающегося в терминал
+     * @param gridWidth Ширина игрового поля
+     * @param gridHeight Высота игрового поля
+     * @param reservedColumns Столбцы терминала, занятые панелями справа от поля
+     * @return Ширина (X) и высота (Y) окна в клетках, не больше размеров поля
+     * @note Оставляет место под рамку, строку счета и строку управления
+     */
+    Position calculateViewportSize(int gridWidth, int gridHeight, int reservedColumns = 0) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file TerminalGeometry.hpp
+ * @brief Заголовочный файл, содержащий объявление класса TerminalGeometry
+ */
+#ifndef TERMINALGEOMETRY
+#define TERMINALGEOMETRY
+
+#include <atomic>
+#include <mutex>
+#include <signal.h>
+
+/**
+ * @brief Размер терминала в символах
+ */
+struct TerminalSize {
+    int columns; /**< Ширина терминала */
+    int rows;    /**< Высота терминала */
+};
+
+/**
+ * @brief Общий кэш размера терминала
+ *
+ * Размер запрашивается через ioctl(TIOCGWINSZ) только после того, как
+ * кэш был помечен устаревшим обработчиком SIGWINCH, поэтому отрисовка
+ * хода не выполняет системных вызовов, а все части одного кадра
+ * используют одинаковую геометрию. Каждый обработчик SIGWINCH в
+ * программе должен вызывать invalidate().
+ *
+ * Кэш читают поток управления и поток отрисовки: флаг и номер версии
+ * атомарны, размер защищен _mutex (обработчик сигнала его не захватывает).
+ */
+class TerminalGeometry {
+private:
+    static std::atomic<int> _stale;      /**< Флаг устаревшего кэша (выставляется из обработчика сигнала) */
+    static std::mutex _mutex;            /**< Защищает _size и _fixed между потоками */
+    static TerminalSize _size;           /**< Кэшированный размер (под _mutex) */
+    static std::atomic<unsigned> _generation; /**< Номер версии размера, растет при каждом изменении */
+    static bool _fixed;                  /**< Размер задан программно и не запрашивается у терминала (под _mutex) */
+
+    static_assert(std::atomic<int>::is_always_lock_free, "Resize flag must be async-signal-safe");
+
+public:
+    static const int FALLBACK_COLUMNS = 80; /**< Ширина, если вывод не является терминалом */
+    static const int FALLBACK_ROWS = 24;    /**< Высота, если вывод не является терминалом */
+
+    /**
+     * @brief Возвращает размер терминала
+     * @return Кэшированный размер (перечитывается, если кэш устарел)
+     */
+    static TerminalSize get();
+
+    /**
+     * @brief Возвращает ширину терминала
+     */
+    static int columns() { return get().columns; }
+
+    /**
+     * @brief Возвращает высоту терминала
+     */
+    static int rows() { return get().rows; }
+
+    /**
+     * @brief Возвращает номер версии размера
+     * @return Значение, меняющееся при каждом изменении размера
+     * @note Позволяет кэшировать зависящие от размера вычисления раскладки
+     */
+    static unsigned getGeneration();
+
+    /**
+     * @brief Помечает кэш устаревшим
+     * @note Async-signal-safe: только записывает атомарный флаг без блокировки
+     */
+    static void invalidate() { _stale.store(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Обработчик SIGWINCH, который только помечает кэш устаревшим
+     * @param sig Номер сигнала
+     * @note Используется вместо SIG_IGN там, где перерисовка по сигналу не нужна
+     */
+    static void onResizeSignal(int sig);
+
+    /**
+     * @brief Фиксирует размер независимо от реального терминала
+     * @param size Размер, который будет возвращать get()
+     * @note Для запуска без TTY (сценарии, бенчмарки), чтобы раскладка была воспроизводимой
+     */
+    static void setFixedSize(TerminalSize size);
+
+    /**
+     * @brief Отменяет фиксированный размер
+     * @note Следующий get() снова запросит размер у терминала
+     */
+    static void releaseFixedSize();
+};
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file TerminalSink.hpp
+ * @brief Заголовочный файл, содержащий объявление класса TerminalSink
+ */
+#ifndef TERMINALSINK
+#define TERMINALSINK
+
+#include "view/CountingSink.hpp"
+
+/**
+ * @brief Приемник вывода, передающий сброшенные байты в дескриптор терминала
+ *
+ * Считает байты и записи так же, как CountingSink, поэтому объем
+ * каждого кадра виден и в настоящем терминале. Каждый сброс буфера -
+ * один вызов write().
+ */
+class TerminalSink : public CountingSink {
+private:
+    int _fd; /**< Дескриптор терминала (не владеет) */
+
+public:
+    /**
+     * @brief Конструктор приемника
+     * @param fd Дескриптор, в который пишется вывод
+     */
+    explicit TerminalSink(int fd);
+
+protected:
+    /**
+     * @brief Записывает сброшенные байты в дескриптор
+     * @param data Байты
+     * @param length Количество байт
+     * @note Прерванная сигналом или частичная запись продолжается; ошибка записи отбрасывает остаток
+     */
+    void consume(const char* data, size_t length) override;
+};
+
+#endif
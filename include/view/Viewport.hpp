@@ -0,0 +1,98 @@
+/**
+ * @file Viewport.hpp
+ * @brief Заголовочный файл, содержащий объявление класса Viewport
+ */
+#ifndef VIEWPORT
+#define VIEWPORT
+
+#include "model/Position.hpp"
+
+/**
+ * @brief Окно просмотра (камера) игрового поля
+ *
+ * Определяет видимую часть поля, когда оно не помещается в терминал.
+ * Камера следует за игроком с мертвой зоной: окно сдвигается только
+ * когда игрок выходит за внутреннюю рамку шириной в четверть окна.
+ */
+class Viewport {
+private:
+    int _boardWidth;  /**< Ширина поля в клетках */
+    int _boardHeight; /**< Высота поля в клетках */
+    int _width;       /**< Ширина окна в клетках */
+    int _height;      /**< Высота окна в клетках */
+    Position _origin; /**< Левая верхняя клетка окна */
+
+public:
+    /**
+     * @brief Конструктор окна просмотра
+     * @param boardWidth Ширина поля
+     * @param boardHeight Высота поля
+     * @param width Ширина окна (обрезается до ширины поля)
+     * @param height Высота окна (обрезается до высоты поля)
+     */
+    Viewport(int boardWidth, int boardHeight, int width, int height);
+
+    /**
+     * @brief Изменяет размер окна
+     * @param width Новая ширина окна
+     * @param height Новая высота окна
+     * @note Начало окна корректируется, чтобы окно не выходило за поле
+     */
+    void resize(int width, int height);
+
+    /**
+     * @brief Центрирует окно на клетке
+     * @param target Клетка поля
+     */
+    void centerOn(const Position& target);
+
+    /**
+     * @brief Сдвигает окно так, чтобы клетка оказалась внутри мертвой зоны
+     * @param target Клетка поля (обычно позиция игрока)
+     * @return Сдвиг начала окна в клетках (нулевой, если окно не сдвинулось)
+     */
+    Position follow(const Position& target);
+
+    /**
+     * @brief Проверяет, видна ли клетка
+     * @param position Клетка поля
+     * @return true если клетка попадает в окно
+     */
+    bool contains(const Position& position) const;
+
+    /**
+     * @brief Переводит координаты поля в координаты окна
+     * @param position Клетка поля
+     * @return Позиция относительно левого верхнего угла окна
+     */
+    Position toLocal(const Position& position) const;
+
+    /**
+     * @brief Проверяет, помещается ли поле в окно целиком
+     * @return true если прокрутка не нужна
+     */
+    bool coversBoard() const;
+
+    /**
+     * @brief Возвращает левую верхнюю клетку окна
+     */
+    Position getOrigin() const { return _origin; }
+
+    /**
+     * @brief Возвращает ширину окна в клетках
+     */
+    int getWidth() const { return _width; }
+
+    /**
+     * @brief Возвращает высоту окна в клетках
+     */
+    int getHeight() const { return _height; }
+
+private:
+    /**
+     * @brief Ограничивает начало окна пределами поля
+     */
+    void clampOrigin();
+};
+
+#endif
@@ -0,0 +1,264 @@
+/**
+ * @file VirtualTerminal.hpp
+ * @brief Заголовочный файл, содержащий объявление класса VirtualTerminal
+ */
+#ifndef VIRTUALTERMINAL
+#define VIRTUALTERMINAL
+
+#include "view/CountingSink.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Клетка экрана виртуального терминала
+ */
+struct TerminalCell {
+    char32_t glyph = U' '; /**< Символ (кодовая точка Unicode) */
+    int fg = -1;           /**< Цвет символа (-1 - по умолчанию, 0..15, 16..255, 0x1000000|RGB) */
+    int bg = -1;           /**< Цвет фона (в той же кодировке) */
+    unsigned char attrs = 0; /**< Атрибуты SGR (BOLD, DIM, ...) */
+
+    static const unsigned char BOLD = 1;      /**< Жирный (SGR 1) */
+    static const unsigned char DIM = 2;       /**< Тусклый (SGR 2) */
+    static const unsigned char ITALIC = 4;    /**< Курсив (SGR 3) */
+    static const unsigned char UNDERLINE = 8; /**< Подчеркивание (SGR 4) */
+    static const unsigned char INVERSE = 16;  /**< Инверсия (SGR 7) */
+
+    bool operator==(const TerminalCell& other) const {
+        return glyph == other.glyph && fg == other.fg && bg == other.bg && attrs == other.attrs;
+    }
+    bool operator!=(const TerminalCell& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Счетчики вывода в терминал
+ */
+struct TerminalStats {
+    unsigned long long bytes = 0;       /**< Байт вывода */
+    unsigned long long writes = 0;      /**< Сбросов буфера (вызовов write) */
+    unsigned long long glyphs = 0;      /**< Выведенных символов */
+    unsigned long long cursorMoves = 0; /**< Команд перемещения курсора (CUP, CUU, ...) */
+    unsigned long long sgrChanges = 0;  /**< Команд смены атрибутов (SGR) */
+    unsigned long long scrolls = 0;     /**< Команд прокрутки (SU, SD) */
+    unsigned long long clears = 0;      /**< Команд очистки (ED, EL) */
+};
+
+/**
+ * @brief Виртуальный терминал в памяти
+ *
+ * Приемник вывода, который разбирает ANSI-поток ConsoleRenderer в сетку
+ * клеток: позиционирование курсора, SGR, очистку, области прокрутки
+ * (DECSTBM, SU/SD), автоперенос и альтернативный экран. Перевод строки
+ * обрабатывается как CR LF, как при включенном ONLCR у настоящего TTY.
+ * Кадром считается вывод между двумя std::flush; счетчики ведутся и
+ * за кадр, и за все время. Позволяет измерять стоимость отрисовки и
+ * сравнивать экран после инкрементальной отрисовки с полной перерисовкой.
+ */
+class VirtualTerminal : public CountingSink {
+private:
+    /**
+     * @brief Состояние разбора потока
+     */
+    enum State {
+        GROUND, /**< Обычные символы */
+        ESC,    /**< Получен ESC */
+        CSI,    /**< Получен ESC [ */
+        STRING  /**< Строка OSC/DCS до BEL или ESC \ */
+    };
+
+    static const int MAX_PARAMS = 16; /**< Наибольшее число параметров CSI */
+
+    int _columns;                       /**< Ширина экрана */
+    int _rows;                          /**< Высота экрана */
+    std::vector<TerminalCell> _screens[2]; /**< Основной и альтернативный экраны */
+    int _active;                        /**< Индекс активного экрана */
+    int _cursorX;                       /**< Столбец курсора (с 0) */
+    int _cursorY;                       /**< Строка курсора (с 0) */
+    int _savedX;                        /**< Сохраненный столбец курсора */
+    int _savedY;                        /**< Сохраненная строка курсора */
+    bool _wrapPending;                  /**< Курсор стоит за последним столбцом (отложенный перенос) */
+    bool _autowrap;                     /**< Режим автопереноса (DECAWM) */
+    bool _cursorVisible;                /**< Видимость курсора (DECTCEM) */
+    int _scrollTop;                     /**< Верхняя строка области прокрутки */
+    int _scrollBottom;                  /**< Нижняя строка области прокрутки */
+    TerminalCell _pen;                  /**< Текущие атрибуты вывода */
+
+    State _state;                       /**< Состояние разбора */
+    int _params[MAX_PARAMS];            /**< Параметры CSI */
+    int _paramCount;                    /**< Количество параметров */
+    bool _private;                      /**< CSI с префиксом '?' */
+    char32_t _codepoint;                /**< Накопленная кодовая точка UTF-8 */
+    int _utf8Remaining;                 /**< Ожидаемых байт продолжения UTF-8 */
+
+    TerminalStats _totals;              /**< Счетчики за все время */
+    TerminalStats _frame;               /**< Счетчики текущего кадра */
+    TerminalStats _lastFrame;           /**< Счетчики последнего завершенного кадра */
+    unsigned long long _frames;         /**< Завершенных кадров */
+
+public:
+    /**
+     * @brief Конструктор виртуального терминала
+     * @param columns Ширина экрана
+     * @param rows Высота экрана
+     * @throws std::invalid_argument если размер не положительный
+     */
+    VirtualTerminal(int columns, int rows);
+
+    /**
+     * @brief Возвращает клетку активного экрана
+     * @param x Столбец (с 0)
+     * @param y Строка (с 0)
+     * @return Клетка
+     * @throws std::out_of_range если клетка вне экрана
+     */
+    const TerminalCell& at(int x, int y) const;
+
+    /**
+     * @brief Возвращает текст строки экрана без атрибутов
+     * @param y Строка (с 0)
+     * @return Строка в UTF-8
+     */
+    std::string rowText(int y) const;
+
+    /**
+     * @brief Сравнивает активные экраны двух терминалов
+     * @param other Другой терминал
+     * @return true если размеры и все клетки совпадают
+     */
+    bool sameScreen(const VirtualTerminal& other) const;
+
+    /**
+     * @brief Считает клетки, отличающиеся от другого терминала
+     * @param other Другой терминал того же размера
+     * @return Количество отличающихся клеток
+     */
+    int countDifferences(const VirtualTerminal& other) const;
+
+    int getColumns() const { return _columns; }
+    int getRows() const { return _rows; }
+    int getCursorX() const { return _cursorX; }
+    int getCursorY() const { return _cursorY; }
+    bool isCursorVisible() const { return _cursorVisible; }
+    bool isAlternateScreen() const { return _active == 1; }
+
+    /**
+     * @brief Возвращает счетчики за все время
+     */
+    const TerminalStats& getTotals() const { return _totals; }
+
+    /**
+     * @brief Возвращает счетчики последнего кадра (вывод до последнего std::flush)
+     */
+    const TerminalStats& getLastFrame() const { return _lastFrame; }
+
+    /**
+     * @brief Возвращает количество завершенных кадров
+     */
+    unsigned long long getFrames() const { return _frames; }
+
+    /**
+     * @brief Обнуляет счетчики, не трогая содержимое экрана
+     */
+    void resetStats();
+
+protected:
+    /**
+     * @brief Сбрасывает буфер и завершает кадр
+     * @return 0
+     */
+    int sync() override;
+
+    /**
+     * @brief Разбирает сброшенные байты
+     * @param data Байты
+     * @param length Количество байт
+     */
+    void consume(const char* data, size_t length) override;
+
+private:
+    std::vector<TerminalCell>& screen() { return _screens[_active]; }
+    const std::vector<TerminalCell>& screen() const { return _screens[_active]; }
+
+    /**
+     * @brief Разбирает один байт
+     * @param byte Байт
+     */
+    void process(unsigned char byte);
+
+    /**
+     * @brief Выводит символ в позицию курсора
+     * @param glyph Кодовая точка
+     */
+    void put(char32_t glyph);
+
+    /**
+     * @brief Выполняет управляющий символ (CR, LF, BS, TAB)
+     * @param byte Символ
+     */
+    void control(unsigned char byte);
+
+    /**
+     * @brief Выполняет CSI-последовательность
+     * @param final Завершающий байт
+     */
+    void executeCsi(unsigned char final);
+
+    /**
+     * @brief Применяет параметры SGR
+     */
+    void applySgr();
+
+    /**
+     * @brief Включает или выключает режим DEC (CSI ? n h/l)
+     * @param mode Номер режима
+     * @param enable Включить
+     */
+    void setPrivateMode(int mode, bool enable);
+
+    /**
+     * @brief Переводит строку с прокруткой области
+     */
+    void lineFeed();
+
+    /**
+     * @brief Прокручивает область прокрутки
+     * @param lines Количество строк (положительное - вверх, отрицательное - вниз)
+     */
+    void scroll(int lines);
+
+    /**
+     * @brief Заполняет часть строки пустыми клетками текущего фона
+     * @param y Строка
+     * @param from Первый столбец
+     * @param to Столбец после последнего
+     */
+    void erase(int y, int from, int to);
+
+    /**
+     * @brief Перемещает курсор с ограничением по экрану
+     * @param x Столбец
+     * @param y Строка
+     */
+    void moveCursor(int x, int y);
+
+    /**
+     * @brief Возвращает параметр CSI
+     * @param index Индекс
+     * @param fallback Значение по умолчанию (для отсутствующего или нулевого)
+     */
+    int param(int index, int fallback) const;
+
+    /**
+     * @brief Возвращает пустую клетку с текущим фоном
+     */
+    TerminalCell blank() const;
+
+    /**
+     * @brief Прибавляет счетчики к текущему кадру и итогам
+     * @param field Указатель на поле TerminalStats
+     * @param amount Прибавка
+     */
+    void count(unsigned long long TerminalStats::*field, unsigned long long amount = 1);
+};
+
+#endif
@@ -0,0 +1,322 @@
+#include "api/greed.h"
+#include "model/GameModel.hpp"
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <vector>
+
+struct greed_game {
+    GameModel model;
+    bool finished;
+
+    greed_game(int width, int height, unsigned int seed): model(width, height, seed), finished(false) {}
+
+    greed_game(int width, int height,
+               const std::vector<int>& cellValues,
+               const std::vector<int>& cellColors,
+               const std::vector<int>& cellAvailable,
+               const std::vector<int>& cellTypes,
+               const std::vector<int>& teleportTargetsX,
+               const std::vector<int>& teleportTargetsY,
+               const Position& playerPos,
+               int score,
+               bool gameOver):
+        model(width, height, cellValues, cellColors, cellAvailable, cellTypes,
+              teleportTargetsX, teleportTargetsY, playerPos, score),
+        finished(gameOver) {}
+};
+
+namespace {
+
+const char SERIAL_MAGIC[4] = {'G', 'R', 'D', static_cast<char>(GREED_ABI_VERSION)};
+const size_t SERIAL_HEADER_SIZE = sizeof(SERIAL_MAGIC) + 6 * sizeof(int32_t);
+const size_t SERIAL_CELL_SIZE = 4 + 2 * sizeof(int32_t);
+const int MAX_CELL_VALUE = 9; /**< Наибольшее значение базовой клетки в сериализованных данных */
+
+/**
+ * @brief Перемножает размеры с проверкой переполнения
+ * @param a Первый множитель
+ * @param b Второй множитель
+ * @param product Произведение (записывается при успехе)
+ * @return false если произведение не помещается в size_t
+ */
+bool multiplySize(size_t a, size_t b, size_t& product) {
+    if (a != 0 && b > SIZE_MAX / a)
+        return false;
+    product = a * b;
+    return true;
+}
+
+/**
+ * @brief Вычисляет размер сериализованного поля
+ * @param width Ширина поля (> 0)
+ * @param height Высота поля (> 0)
+ * @return Размер в байтах или 0, если он не помещается в size_t
+ */
+size_t serializedSize(int32_t width, int32_t height) {
+    size_t totalCells = 0;
+    if (!multiplySize(static_cast<size_t>(width), static_cast<size_t>(height), totalCells) ||
+        totalCells > (SIZE_MAX - SERIAL_HEADER_SIZE) / SERIAL_CELL_SIZE)
+        return 0;
+    return SERIAL_HEADER_SIZE + totalCells * SERIAL_CELL_SIZE;
+}
+
+bool isGameOver(const greed_game* game) {
+    return game->finished || game->model.isGameOver();
+}
+
+greed_cell describeCell(const ICell& cell) {
+    greed_cell result;
+    result.available = cell.isAvailable() ? 1 : 0;
+    result.target_x = 0;
+    result.target_y = 0;
+
+    if (cell.getType() == CellType::TELEPORT) {
+        Position tpPos = static_cast<const TeleportCell&>(cell).getTPPos();
+        result.type = GREED_CELL_TELEPORT;
+        result.value = 0;
+        result.color = static_cast<uint8_t>(Color::GREEN);
+        result.target_x = tpPos.getX();
+        result.target_y = tpPos.getY();
+    }
+    else if (cell.getType() == CellType::BOMB) {
+        result.type = GREED_CELL_BOMB;
+        result.value = 0;
+        result.color = static_cast<uint8_t>(Color::RED);
+    }
+    else {
+        const BasicCell& basicCell = static_cast<const BasicCell&>(cell);
+        result.type = GREED_CELL_BASIC;
+        result.value = static_cast<uint8_t>(basicCell.getValue());
+        result.color = static_cast<uint8_t>(basicCell.getColor());
+    }
+
+    return result;
+}
+
+void writeInt(unsigned char*& out, int32_t value) {
+    std::memcpy(out, &value, sizeof(value));
+    out += sizeof(value);
+}
+
+int32_t readInt(const unsigned char*& in) {
+    int32_t value;
+    std::memcpy(&value, in, sizeof(value));
+    in += sizeof(value);
+    return value;
+}
+
+}
+
+extern "C" {
+
+int greed_abi_version(void) {
+    return GREED_ABI_VERSION;
+}
+
+greed_game* greed_create(int32_t width, int32_t height, uint32_t seed) {
+    if (width <= 0 || height <= 0)
+        return nullptr;
+
+    try {
+        return new greed_game(width, height, seed);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void greed_destroy(greed_game* game) {
+    delete game;
+}
+
+int greed_step(greed_game* game, int32_t direction) {
+    if (!game || direction < GREED_UP || direction > GREED_RIGHT)
+        return GREED_ERR_INVALID_ARGUMENT;
+    if (isGameOver(game))
+        return GREED_ERR_GAME_OVER;
+
+    try {
+        game->model.makeMove(static_cast<Direction>(direction));
+    } catch (...) {
+        return GREED_ERR_INTERNAL;
+    }
+    return GREED_OK;
+}
+
+int greed_step_batch(greed_game* game, const uint8_t* directions, size_t count, size_t* applied) {
+    if (applied) *applied = 0;
+    if (!game || (!directions && count > 0))
+        return GREED_ERR_INVALID_ARGUMENT;
+
+    for (size_t i = 0; i < count; i++) {
+        int status = greed_step(game, directions[i]);
+        if (status != GREED_OK)
+            return status;
+        if (applied) *applied = i + 1;
+    }
+    return GREED_OK;
+}
+
+int greed_get_state(const greed_game* game, greed_state* out) {
+    if (!game || !out)
+        return GREED_ERR_INVALID_ARGUMENT;
+
+    const Grid& grid = game->model.getGrid();
+    Position playerPos = game->model.getPlayerPosition();
+    out->width = grid.getWidth();
+    out->height = grid.getHeight();
+    out->player_x = playerPos.getX();
+    out->player_y = playerPos.getY();
+    out->score = game->model.getScore();
+    out->game_over = isGameOver(game) ? 1 : 0;
+    return GREED_OK;
+}
+
+int greed_get_cells(const greed_game* game, greed_cell* out, size_t capacity) {
+    if (!game)
+        return GREED_ERR_INVALID_ARGUMENT;
+
+    const Grid& grid = game->model.getGrid();
+    return greed_get_cells_rect(game, 0, 0, grid.getWidth(), grid.getHeight(), out, capacity);
+}
+
+int greed_get_cells_rect(const greed_game* game, int32_t x, int32_t y, int32_t w, int32_t h,
+                         greed_cell* out, size_t capacity) {
+    if (!game || !out)
+        return GREED_ERR_INVALID_ARGUMENT;
+
+    const Grid& grid = game->model.getGrid();
+    if (x < 0 || y < 0 || w <= 0 || h <= 0 || w > grid.getWidth() - x || h > grid.getHeight() - y)
+        return GREED_ERR_INVALID_ARGUMENT;
+    size_t totalCells = 0;
+    if (!multiplySize(static_cast<size_t>(w), static_cast<size_t>(h), totalCells) || capacity < totalCells)
+        return GREED_ERR_BUFFER_TOO_SMALL;
+
+    for (int row = y; row < y + h; row++) {
+        for (int column = x; column < x + w; column++) {
+            *out++ = describeCell(grid[Position(column, row)]);
+        }
+    }
+    return GREED_OK;
+}
+
+size_t greed_serialized_size(const greed_game* game) {
+    if (!game)
+        return 0;
+
+    const Grid& grid = game->model.getGrid();
+    return serializedSize(grid.getWidth(), grid.getHeight());
+}
+
+int greed_serialize(const greed_game* game, void* buffer, size_t capacity, size_t* written) {
+    if (written) *written = 0;
+    if (!game || !buffer)
+        return GREED_ERR_INVALID_ARGUMENT;
+
+    size_t size = greed_serialized_size(game);
+    if (size == 0)
+        return GREED_ERR_INVALID_ARGUMENT;
+    if (capacity < size)
+        return GREED_ERR_BUFFER_TOO_SMALL;
+
+    greed_state state;
+    greed_get_state(game, &state);
+
+    unsigned char* out = static_cast<unsigned char*>(buffer);
+    std::memcpy(out, SERIAL_MAGIC, sizeof(SERIAL_MAGIC));
+    out += sizeof(SERIAL_MAGIC);
+    writeInt(out, state.width);
+    writeInt(out, state.height);
+    writeInt(out, state.player_x);
+    writeInt(out, state.player_y);
+    writeInt(out, state.score);
+    writeInt(out, state.game_over);
+
+    const Grid& grid = game->model.getGrid();
+    for (int y = 0; y < state.height; y++) {
+        for (int x = 0; x < state.width; x++) {
+            greed_cell cell = describeCell(grid[Position(x, y)]);
+            *out++ = cell.type;
+            *out++ = cell.value;
+            *out++ = cell.color;
+            *out++ = cell.available;
+            writeInt(out, cell.target_x);
+            writeInt(out, cell.target_y);
+        }
+    }
+
+    if (written) *written = size;
+    return GREED_OK;
+}
+
+greed_game* greed_deserialize(const void* buffer, size_t size) {
+    if (!buffer || size < SERIAL_HEADER_SIZE)
+        return nullptr;
+
+    const unsigned char* in = static_cast<const unsigned char*>(buffer);
+    if (std::memcmp(in, SERIAL_MAGIC, sizeof(SERIAL_MAGIC)) != 0)
+        return nullptr;
+    in += sizeof(SERIAL_MAGIC);
+
+    int32_t width = readInt(in);
+    int32_t height = readInt(in);
+    int32_t playerX = readInt(in);
+    int32_t playerY = readInt(in);
+    int32_t score = readInt(in);
+    int32_t gameOver = readInt(in);
+
+    if (width <= 0 || height <= 0)
+        return nullptr;
+    size_t expectedSize = serializedSize(width, height);
+    if (expectedSize == 0 || size != expectedSize)
+        return nullptr;
+    size_t totalCells = (size - SERIAL_HEADER_SIZE) / SERIAL_CELL_SIZE;
+    if (playerX < 0 || playerX >= width || playerY < 0 || playerY >= height)
+        return nullptr;
+    if (gameOver != 0 && gameOver != 1)
+        return nullptr;
+
+    try {
+        std::vector<int> cellValues(totalCells), cellColors(totalCells), cellAvailable(totalCells);
+        std::vector<int> cellTypes(totalCells), teleportTargetsX(totalCells), teleportTargetsY(totalCells);
+
+        // Все поля проверяются до построения игры: движок индексирует поле по ним без проверок
+        for (size_t i = 0; i < totalCells; i++) {
+            int type = *in++;
+            int value = *in++;
+            int color = *in++;
+            int available = *in++;
+            int32_t targetX = readInt(in);
+            int32_t targetY = readInt(in);
+
+            if (available > 1)
+                return nullptr;
+            if (type == GREED_CELL_TELEPORT) {
+                if (targetX < 0 || targetX >= width || targetY < 0 || targetY >= height)
+                    return nullptr;
+            }
+            else if (type == GREED_CELL_BASIC) {
+                if (value > MAX_CELL_VALUE || color > static_cast<int>(Color::DEFAULT))
+                    return nullptr;
+            }
+            else if (type != GREED_CELL_BOMB) {
+                return nullptr;
+            }
+
+            cellTypes[i] = type;
+            cellValues[i] = value;
+            cellColors[i] = color;
+            cellAvailable[i] = available;
+            teleportTargetsX[i] = targetX;
+            teleportTargetsY[i] = targetY;
+        }
+
+        return new greed_game(width, height, cellValues, cellColors, cellAvailable,
+                              cellTypes, teleportTargetsX, teleportTargetsY,
+                              Position(playerX, playerY), score, gameOver != 0);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+}
@@ -1,24 +1,30 @@
 #include "controller/GameController.hpp"
+#include "controller/InputDecoder.hpp"
+#include "view/TerminalGeometry.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/Tracer.hpp"
 #include <unistd.h>
 #include <iostream>
 #include <termios.h>
-#include <sys/ioctl.h>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <cstddef>
 #include <csignal>
 
+volatile sig_atomic_t GameController::_interrupted = 0;
+
 GameController::GameController(GameModel* model, GameView* view): 
     _model(model), _view(view), _paused(false), _shouldReturnToMenu(false),
-    _terminalTooSmall(false), _minTerminalWidth(80), _minTerminalHeight(24) {
+    _terminalTooSmall(false), _minTerminalWidth(80), _minTerminalHeight(24), _input(&InputDecoder::forStdin()),
+    _previousInterrupt(SIG_DFL) {
     _inputHandler = std::make_unique<InputHandler>();
 }
 
 bool GameController::checkTerminalSize() {
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
+    TerminalSize w = TerminalGeometry::get();
     
-    if (w.ws_col < _minTerminalWidth || w.ws_row < _minTerminalHeight) {
+    if (w.columns < _minTerminalWidth || w.rows < _minTerminalHeight) {
         _terminalTooSmall = true;
         return false;
     }
@@ -28,8 +34,7 @@ bool GameController::checkTerminalSize() {
 }
 
 void GameController::showTerminalTooSmallMessage() {
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
+    TerminalSize w = TerminalGeometry::get();
     
     clearScreen();
     
@@ -39,10 +44,10 @@ void GameController::showTerminalTooSmallMessage() {
     std::cout << " Height: " << _minTerminalHeight << " rows \n";
     
     std::cout << "Current terminal size: \n";
-    std::cout << " Width:  " << w.ws_col << " columns";
-    for (int i = 0; i < 37 - std::to_string(w.ws_col).length(); i++) std::cout << " ";
-    std::cout << "Height: " << w.ws_row << " rows";
-    for (int i = 0; i < 39 - std::to_string(w.ws_row).length(); i++) std::cout << " ";
+    std::cout << " Width:  " << w.columns << " columns";
+    for (int i = 0; i < 37 - std::to_string(w.columns).length(); i++) std::cout << " ";
+    std::cout << "Height: " << w.rows << " rows";
+    for (int i = 0; i < 39 - std::to_string(w.rows).length(); i++) std::cout << " ";
     
     std::cout << "Press 'R' to retry after resizing                       \n";
     std::cout << "Press 'M' to return to main menu                        \n";            
@@ -61,17 +66,28 @@ void GameController::setMenuCallback(std::function<bool()> callback) {
     _menuCallback = callback;
 }
 
+void GameController::setMoveCallback(std::function<void(std::chrono::steady_clock::time_point)> callback) {
+    _moveCallback = callback;
+}
+
+void GameController::setInputDecoder(InputDecoder* input) {
+    _input = input;
+}
+
 void GameController::startGame() {
-    std::signal(SIGINT, [](int sig) {
-        std::cout << "\033[?1049l";
-        system("clear");
-        std::cout << "\033[1;36m" << "Game interrupted. Goodbye!" << "\033[0m" << std::endl;
-        std::exit(0);
-    });
+    GREED_TRACE_SCOPE("game", "startGame");
+    // Обработчик только выставляет флаг: поток отрисовки пишет в std::cout, пока его не остановит цикл
+    _interrupted = 0;
+    _previousInterrupt = std::signal(SIGINT, onInterrupt);
+    if (_previousInterrupt == SIG_ERR) {
+        _previousInterrupt = SIG_DFL;
+    }
     
     std::cout << "\033[?1049h\033[2J\033[1;1H";
     std::cout.flush();
     
+    InputDecoder& input = *_input;
+
     if (!checkTerminalSize()) {
         showTerminalTooSmallMessage();
         
@@ -84,20 +100,23 @@ void GameController::startGame() {
         tcsetattr(STDIN_FILENO, TCSANOW, &newt);
         
         while (_terminalTooSmall && !_shouldReturnToMenu) {
-            char input;
-            int bytesRead = read(STDIN_FILENO, &input, 1);
-            
-            if (bytesRead > 0) {
-                if (tolower(input) == 'r') {
+            if (_interrupted) {
+                exitOnInterrupt(oldt);
+            }
+
+            KeyEvent event;
+            if (input.waitEvent(event, 10)) {
+                char key = event.key();
+                if (key == 'r') {
                     if (checkTerminalSize()) {
                         break;
                     } else {
                         showTerminalTooSmallMessage();
                     }
-                } else if (tolower(input) == 'm') {
+                } else if (key == 'm') {
                     _shouldReturnToMenu = true;
                     break;
-                } else if (tolower(input) == 'q') {
+                } else if (key == 'q') {
                     std::cout << "\033[?1049l";
                     std::cout << "\033[2J\033[1;1H";
                     std::cout << "Goodbye!" << std::endl;
@@ -112,13 +131,12 @@ void GameController::startGame() {
                 }
                 checkCounter = 0;
             }
-            
-            usleep(10000);
         }
         
         tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
         
         if (_shouldReturnToMenu) {
+            std::signal(SIGINT, _previousInterrupt);
             std::cout << "\033[?1049l";
             return;
         }
@@ -142,22 +160,35 @@ void GameController::startGame() {
     
     _model->initializeGame();
     _view->renderStatringState();
+    _view->startRendering();
 
     bool waitingForSpace = false;
     Direction currentDirection = Direction::NONE;
     
     while (!_model->isGameOver() && !_shouldReturnToMenu) {
+        if (_interrupted) {
+            exitOnInterrupt(oldt);
+        }
+
+        if (!_paused) {
+            _view->handlePendingResize();
+        }
+
         static int sizeCheckCounter = 0;
         if (++sizeCheckCounter % 500 == 0) {
             if (!checkTerminalSize()) {
+                _view->waitForIdle();
                 showTerminalTooSmallMessage();
                 
                 while (_terminalTooSmall && !_shouldReturnToMenu) {
-                    char input;
-                    int bytesRead = read(STDIN_FILENO, &input, 1);
-                    
-                    if (bytesRead > 0) {
-                        if (tolower(input) == 'r') {
+                    if (_interrupted) {
+                        exitOnInterrupt(oldt);
+                    }
+
+                    KeyEvent event;
+                    if (input.waitEvent(event, 10)) {
+                        char key = event.key();
+                        if (key == 'r') {
                             if (checkTerminalSize()) {
                                 clearScreen();
                                 _view->refresh();
@@ -165,10 +196,10 @@ void GameController::startGame() {
                             } else {
                                 showTerminalTooSmallMessage();
                             }
-                        } else if (tolower(input) == 'm') {
+                        } else if (key == 'm') {
                             _shouldReturnToMenu = true;
                             break;
-                        } else if (tolower(input) == 'q') {
+                        } else if (key == 'q') {
                             std::cout << "\033[?1049l";
                             std::cout << "\033[2J\033[1;1H";
                             std::cout << "Goodbye!" << std::endl;
@@ -185,8 +216,6 @@ void GameController::startGame() {
                         }
                         retryCounter = 0;
                     }
-                    
-                    usleep(10000);
                 }
                 
                 if (_shouldReturnToMenu) break;
@@ -194,160 +223,122 @@ void GameController::startGame() {
             sizeCheckCounter = 0;
         }
         
-        char input;
-        int bytesRead = read(STDIN_FILENO, &input, 1);
-        
-        if (bytesRead > 0) {
+        KeyEvent event;
+        if (!input.waitEvent(event, 10)) {
+            if (input.exhausted()) {
+                break;
+            }
+        } else if (!event.pasted) {
+            auto keyTime = std::chrono::steady_clock::now();
+            char key = event.key();
+            Direction direction = event.direction();
+
             if (_paused) {
-                if (tolower(input) == 'p') {
+                if (key == 'p') {
                     _paused = false;
                     _view->refresh();
                 }
-                else if (tolower(input) == 'm') {
+                else if (key == 'm' || event.kind == KeyEvent::ESCAPE) {
                     _shouldReturnToMenu = true;
                 }
-                else if (tolower(input) == 'f') {
-                    if (_saveCallback) _saveCallback();
-                }
-                else if (input == 27) {
-                    char next;
-                    if (read(STDIN_FILENO, &next, 1) > 0) {
-                        if (next == '[') {
-                            char arrow;
-                            read(STDIN_FILENO, &arrow, 1);
-                        } else {
-                            _shouldReturnToMenu = true;
-                        }
-                    } else {
-                        _shouldReturnToMenu = true;
+                else if (key == 'f') {
+                    if (_saveCallback) {
+                        _view->waitForIdle();
+                        _saveCallback();
                     }
                 }
-            } else {
-                if (waitingForSpace) {
-                    Direction newDir = Direction::NONE;
-                    
-                    if (input == 27) {
-                        char next;
-                        if (read(STDIN_FILENO, &next, 1) > 0) {
-                            if (next == '[') {
-                                char arrow;
-                                if (read(STDIN_FILENO, &arrow, 1) > 0) {
-                                    switch(arrow) {
-                                        case 'A': newDir = Direction::UP; break;
-                                        case 'B': newDir = Direction::DOWN; break;
-                                        case 'C': newDir = Direction::RIGHT; break;
-                                        case 'D': newDir = Direction::LEFT; break;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    else if (input == 'w' || input == 'W') {
-                        newDir = Direction::UP;
-                    }
-                    else if (input == 'a' || input == 'A') {
-                        newDir = Direction::LEFT;
-                    }
-                    else if (input == 's' || input == 'S') {
-                        newDir = Direction::DOWN;
-                    }
-                    else if (input == 'd' || input == 'D') {
-                        newDir = Direction::RIGHT;
-                    }
-                    
-                    if (newDir != Direction::NONE) {
-                        currentDirection = newDir;
-                        auto& availableMoves = _model->getAvailableMoves();
-                        _view->highlightMoveDirection(availableMoves, currentDirection);
-                    }
-                    else if (input == ' ') {
+            } else if (waitingForSpace) {
+                if (direction != Direction::NONE) {
+                    currentDirection = direction;
+                    auto lock = _view->lockModel();
+                    auto& availableMoves = _model->getAvailableMoves();
+                    _view->highlightMoveDirection(availableMoves, currentDirection);
+                }
+                else if (event.kind == KeyEvent::SPACE) {
+                    MoveTiming timing;
+                    timing.readTime = event.time;
+                    timing.decodedTime = keyTime;
+                    {
+                        auto lock = _view->lockModel();
                         _model->makeMove(currentDirection);
-                        _view->renderMove();
-                        waitingForSpace = false;
-                        currentDirection = Direction::NONE;
                     }
-                    else if (input == 27) { 
-                        _view->refresh();
-                        waitingForSpace = false;
-                        currentDirection = Direction::NONE;
+                    timing.appliedTime = std::chrono::steady_clock::now();
+                    _view->renderMove(timing);
+                    waitingForSpace = false;
+                    currentDirection = Direction::NONE;
+                    if (_moveCallback) {
+                        _moveCallback(keyTime);
                     }
-                    else if (tolower(input) == 'p') {
-                        _paused = true;
-                        waitingForSpace = false;
-                        currentDirection = Direction::NONE;
+                }
+                else if (event.kind == KeyEvent::ESCAPE) {
+                    _view->refresh();
+                    waitingForSpace = false;
+                    currentDirection = Direction::NONE;
+                }
+                else if (key == 'p') {
+                    _paused = true;
+                    waitingForSpace = false;
+                    currentDirection = Direction::NONE;
+                }
+                else if (key == 'l') {
+                    _view->toggleLatencyOverlay();
+                    waitingForSpace = false;
+                    currentDirection = Direction::NONE;
+                }
+                else if (key == 'i') {
+                    _view->toggleStatsOverlay();
+                    waitingForSpace = false;
+                    currentDirection = Direction::NONE;
+                }
+                else if (key == 'f') {
+                    if (_saveCallback) {
+                        _view->waitForIdle();
+                        _saveCallback();
                     }
-                    else if (tolower(input) == 'f') {
-                        if (_saveCallback) _saveCallback();
+                }
+                else if (key == 'm') {
+                    _shouldReturnToMenu = true;
+                    waitingForSpace = false;
+                    currentDirection = Direction::NONE;
+                }
+            } else {
+                if (direction != Direction::NONE) {
+                    currentDirection = direction;
+                    auto lock = _view->lockModel();
+                    auto& availableMoves = _model->getAvailableMoves();
+                    _view->highlightMoveDirection(availableMoves, currentDirection);
+                    waitingForSpace = true;
+                }
+                else if (key == 'p') {
+                    _paused = true;
+                }
+                else if (key == 'l') {
+                    _view->toggleLatencyOverlay();
+                }
+                else if (key == 'i') {
+                    _view->toggleStatsOverlay();
+                }
+                else if (key == 'f') {
+                    if (_saveCallback) {
+                        _view->waitForIdle();
+                        _saveCallback();
                     }
-                    else if (tolower(input) == 'm') {
+                }
+                else if (key == 'm' || event.kind == KeyEvent::ESCAPE) {
+                    if (_menuCallback && _menuCallback()) {
                         _shouldReturnToMenu = true;
-                        waitingForSpace = false;
-                        currentDirection = Direction::NONE;
-                    }
-                } else {
-                    Direction arrowDir = Direction::NONE;
-                    
-                    if (input == 27) {
-                        char next;
-                        if (read(STDIN_FILENO, &next, 1) > 0) {
-                            if (next == '[') {
-                                char arrow;
-                                if (read(STDIN_FILENO, &arrow, 1) > 0) {
-                                    switch(arrow) {
-                                        case 'A': arrowDir = Direction::UP; break;
-                                        case 'B': arrowDir = Direction::DOWN; break;
-                                        case 'C': arrowDir = Direction::RIGHT; break;
-                                        case 'D': arrowDir = Direction::LEFT; break;
-                                    }
-                                }
-                            } else {
-                                if (_menuCallback && _menuCallback()) {
-                                    _shouldReturnToMenu = true;
-                                }
-                            }
-                        } else {
-                            if (_menuCallback && _menuCallback()) {
-                                _shouldReturnToMenu = true;
-                            }
-                        }
-                    }
-                    else if (tolower(input) == 'p') {
-                        _paused = true;
-                    }
-                    else if (tolower(input) == 'f') {
-                        if (_saveCallback) _saveCallback();
-                    }
-                    else if (tolower(input) == 'm') {
-                        if (_menuCallback && _menuCallback()) {
-                            _shouldReturnToMenu = true;
-                        }
-                    }
-                    else if (input == 'w' || input == 'W' || input == 'a' || input == 'A' || 
-                             input == 's' || input == 'S' || input == 'd' || input == 'D') {
-                        
-                        switch(tolower(input)) {
-                            case 'w': arrowDir = Direction::UP; break;
-                            case 'a': arrowDir = Direction::LEFT; break;
-                            case 's': arrowDir = Direction::DOWN; break;
-                            case 'd': arrowDir = Direction::RIGHT; break;
-                        }
-                    }
-                    
-                    if (arrowDir != Direction::NONE) {
-                        currentDirection = arrowDir;
-                        auto& availableMoves = _model->getAvailableMoves();
-                        _view->highlightMoveDirection(availableMoves, currentDirection);
-                        waitingForSpace = true;
                     }
                 }
             }
         }
         
         if (_paused && !waitingForSpace) {
-            struct winsize w;
-            ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-            int terminalWidth = w.ws_col;
-            int terminalHeight = w.ws_row;
+            _view->waitForIdle();
+            GREED_ALLOCATION_PHASE(RENDER);
+
+            TerminalSize w = TerminalGeometry::get();
+            int terminalWidth = w.columns;
+            int terminalHeight = w.rows;
             
             if (terminalWidth < 40 || terminalHeight < 13) {
                 std::cout << "\033[2J\033[1;1H";
@@ -370,7 +361,7 @@ void GameController::startGame() {
                 if (horizontalPadding < 0) horizontalPadding = 0;
                 
                 int score = _model->getScore();
-                std::string scoreColorCode;
+                const char* scoreColorCode;
                 if (score >= 0 && score <= 100) {
                     scoreColorCode = "\033[1;31m";
                 } else if (score >= 101 && score <= 200) {
@@ -391,26 +382,28 @@ void GameController::startGame() {
                     }
                 }
                 
-                std::string title = "GAME PAUSED";
-                int titleX = horizontalPadding + (pauseWidth - title.length()) / 2;
+                // Экран паузы перерисовывается на каждой итерации цикла: без временных строк в куче
+                const char* title = "GAME PAUSED";
+                int titleX = horizontalPadding + (pauseWidth - static_cast<int>(std::strlen(title))) / 2;
                 int titleY = verticalPadding + 2;
                 std::cout << "\033[" << titleY << ";" << titleX << "H";
                 std::cout << "\033[1;35m" << title << "\033[0m";
                 
-                std::string scoreText = "Score: " + std::to_string(score);
-                int scoreX = horizontalPadding + (pauseWidth - scoreText.length()) / 2;
+                char scoreText[32];
+                int scoreLength = std::snprintf(scoreText, sizeof(scoreText), "Score: %d", score);
+                int scoreX = horizontalPadding + (pauseWidth - scoreLength) / 2;
                 int scoreY = verticalPadding + 4;
                 std::cout << "\033[" << scoreY << ";" << scoreX << "H";
                 std::cout << scoreColorCode << scoreText << "\033[0m";
                 
-                std::vector<std::pair<std::string, std::string>> buttons = {
-                    {"P", "Resume Game"},
-                    {"F", "Save Game"}, 
-                    {"M", "Main Menu"},
-                    {"ESC", "Exit"}
+                static const char* const buttons[] = {
+                    "P - Resume Game",
+                    "F - Save Game", 
+                    "M - Main Menu",
+                    "ESC - Exit"
                 };
                 
-                std::vector<std::string> buttonColors = {
+                static const char* const buttonColors[] = {
                     "\033[1;32m",
                     "\033[1;34m", 
                     "\033[1;35m",
@@ -418,17 +411,17 @@ void GameController::startGame() {
                 };
                 
                 int buttonStartY = verticalPadding + 6;
-                for (size_t i = 0; i < buttons.size(); i++) {
-                    std::string buttonText = buttons[i].first + " - " + buttons[i].second;
-                    int buttonX = horizontalPadding + (pauseWidth - buttonText.length()) / 2;
+                for (size_t i = 0; i < sizeof(buttons) / sizeof(buttons[0]); i++) {
+                    const char* buttonText = buttons[i];
+                    int buttonX = horizontalPadding + (pauseWidth - static_cast<int>(std::strlen(buttonText))) / 2;
                     int buttonY = buttonStartY + i;
                     
                     std::cout << "\033[" << buttonY << ";" << buttonX << "H";
                     std::cout << buttonColors[i] << buttonText << "\033[0m";
                 }
                 
-                std::string hint = "Press key to select...";
-                int hintX = horizontalPadding + (pauseWidth - hint.length()) / 2;
+                const char* hint = "Press key to select...";
+                int hintX = horizontalPadding + (pauseWidth - static_cast<int>(std::strlen(hint))) / 2;
                 int hintY = verticalPadding + 11;
                 std::cout << "\033[" << hintY << ";" << hintX << "H";
                 std::cout << "\033[3;90m" << hint << "\033[0m";
@@ -436,17 +429,18 @@ void GameController::startGame() {
                 std::cout.flush();
             }
         }
-        
-        usleep(10000);
     }
     
+    _view->stopRendering();
     tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGINT, _previousInterrupt);
     std::cout << "\033[?1049l";
     
     if (_model->isGameOver() && !_shouldReturnToMenu) {
         _view->highlightGameOver();
-        sleep(2);
+        if (input.isInteractive()) {
+            sleep(2);
+        }
     }
 }
 
@@ -454,3 +448,20 @@ void GameController::clearScreen() {
     std::cout << "\033[2J\033[1;1H";
     std::cout.flush();
 }
+
+void GameController::onInterrupt(int sig) {
+    if (sig == SIGINT) {
+        _interrupted = 1;
+    }
+}
+
+void GameController::exitOnInterrupt(const struct termios& terminal) {
+    _view->stopRendering();
+    tcsetattr(STDIN_FILENO, TCSANOW, &terminal);
+    std::signal(SIGINT, _previousInterrupt);
+    std::cout << "\033[?7h\033[?1049l";
+    std::cout.flush();
+    system("clear");
+    std::cout << "\033[1;36m" << "Game interrupted. Goodbye!" << "\033[0m" << std::endl;
+    std::exit(0);
+}
@@ -0,0 +1,308 @@
+#include "controller/InputDecoder.hpp"
+#include "core/Tracer.hpp"
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+
+const size_t InputDecoder::BUFFER_SIZE;
+const int InputDecoder::MAX_PARAMS;
+const int InputDecoder::ESCAPE_TIMEOUT_MS;
+
+char KeyEvent::key() const {
+    if (kind != CHAR || pasted) {
+        return 0;
+    }
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+}
+
+Direction KeyEvent::direction() const {
+    if (pasted) {
+        return Direction::NONE;
+    }
+
+    switch (kind) {
+        case UP:
+            return Direction::UP;
+        case DOWN:
+            return Direction::DOWN;
+        case LEFT:
+            return Direction::LEFT;
+        case RIGHT:
+            return Direction::RIGHT;
+        default:
+            break;
+    }
+
+    switch (key()) {
+        case 'w':
+            return Direction::UP;
+        case 's':
+            return Direction::DOWN;
+        case 'a':
+            return Direction::LEFT;
+        case 'd':
+            return Direction::RIGHT;
+        default:
+            return Direction::NONE;
+    }
+}
+
+InputDecoder::InputDecoder(int fd): _fd(fd), _head(0), _tail(0), _state(GROUND), _paramLength(0), _inPaste(false),
+    _eof(fd < 0) {}
+
+InputDecoder& InputDecoder::forStdin() {
+    static InputDecoder decoder(STDIN_FILENO);
+    return decoder;
+}
+
+size_t InputDecoder::fill() {
+    if (_eof || buffered() == BUFFER_SIZE) {
+        return 0;
+    }
+
+    struct pollfd descriptor = {_fd, POLLIN, 0};
+    if (poll(&descriptor, 1, 0) <= 0) {
+        return 0;
+    }
+    if (!(descriptor.revents & (POLLIN | POLLHUP))) {
+        // Ошибка дескриптора не пройдет: считать ее концом ввода, иначе ожидание крутится вхолостую
+        if (descriptor.revents & (POLLERR | POLLNVAL)) {
+            _eof = true;
+        }
+        return 0;
+    }
+
+    GREED_TRACE_SCOPE("input", "read");
+
+    // Один read в непрерывный участок кольца: до конца массива или до _head
+    size_t start = _tail & (BUFFER_SIZE - 1);
+    size_t contiguous = BUFFER_SIZE - start;
+    size_t space = BUFFER_SIZE - buffered();
+    size_t length = contiguous < space ? contiguous : space;
+
+    ssize_t bytesRead = read(_fd, _buffer + start, length);
+    if (bytesRead == 0 || (bytesRead < 0 && errno != EINTR && errno != EAGAIN)) {
+        // EIO после закрытия терминала - тоже конец ввода
+        _eof = true;
+    }
+    if (bytesRead <= 0) {
+        return 0;
+    }
+
+    _tail += static_cast<size_t>(bytesRead);
+    _readTime = std::chrono::steady_clock::now();
+    return static_cast<size_t>(bytesRead);
+}
+
+size_t InputDecoder::feed(const char* data, size_t length) {
+    size_t accepted = 0;
+    while (accepted < length && buffered() < BUFFER_SIZE) {
+        _buffer[_tail & (BUFFER_SIZE - 1)] = static_cast<unsigned char>(data[accepted]);
+        _tail++;
+        accepted++;
+    }
+    _readTime = std::chrono::steady_clock::now();
+    return accepted;
+}
+
+bool InputDecoder::isInteractive() const {
+    return _fd >= 0 && isatty(_fd);
+}
+
+void InputDecoder::clear() {
+    _head = _tail;
+    _state = GROUND;
+    _paramLength = 0;
+}
+
+int InputDecoder::escapeRemainingMs() const {
+    if (_state == GROUND) {
+        return -1;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - _escapeTime
+    ).count();
+    return elapsed >= ESCAPE_TIMEOUT_MS ? 0 : ESCAPE_TIMEOUT_MS - static_cast<int>(elapsed);
+}
+
+void InputDecoder::decodeGround(unsigned char byte, KeyEvent& event) const {
+    event.ch = static_cast<char>(byte);
+
+    if (byte == ' ') {
+        event.kind = KeyEvent::SPACE;
+    } else if (byte == '\r' || byte == '\n') {
+        event.kind = KeyEvent::ENTER;
+    } else {
+        event.kind = KeyEvent::CHAR;
+    }
+}
+
+void InputDecoder::decodeCsi(unsigned char final, KeyEvent& event) {
+    switch (final) {
+        case 'A':
+            event.kind = KeyEvent::UP;
+            return;
+        case 'B':
+            event.kind = KeyEvent::DOWN;
+            return;
+        case 'C':
+            event.kind = KeyEvent::RIGHT;
+            return;
+        case 'D':
+            event.kind = KeyEvent::LEFT;
+            return;
+        case '~':
+            if (_paramLength == 3 && std::memcmp(_params, "200", 3) == 0) {
+                _inPaste = true;
+                event.kind = KeyEvent::PASTE_BEGIN;
+                return;
+            }
+            if (_paramLength == 3 && std::memcmp(_params, "201", 3) == 0) {
+                _inPaste = false;
+                event.kind = KeyEvent::PASTE_END;
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    event.kind = KeyEvent::UNKNOWN;
+}
+
+bool InputDecoder::next(KeyEvent& event) {
+    event = KeyEvent();
+    event.time = _readTime;
+    // Флаг берется до разбора: конец вставки еще относится к ней, начало - уже нет
+    event.pasted = _inPaste;
+    if (buffered() == 0 && _state == GROUND) {
+        return false;
+    }
+
+    GREED_TRACE_SCOPE("input", "decode");
+
+    while (buffered() > 0) {
+        unsigned char byte = _buffer[_head & (BUFFER_SIZE - 1)];
+        _head++;
+
+        switch (_state) {
+            case GROUND:
+                if (byte == 0x1b) {
+                    _state = ESC;
+                    _escapeTime = std::chrono::steady_clock::now();
+                    continue;
+                }
+                decodeGround(byte, event);
+                return true;
+
+            case ESC:
+                if (byte == '[') {
+                    _state = CSI;
+                    _paramLength = 0;
+                    continue;
+                }
+                if (byte == 'O') {
+                    _state = SS3;
+                    continue;
+                }
+                // ESC перед обычным байтом - отдельное нажатие ESC, байт разбирается заново
+                _head--;
+                _state = GROUND;
+                event.kind = KeyEvent::ESCAPE;
+                return true;
+
+            case CSI:
+                if (byte >= 0x20 && byte <= 0x3f) {
+                    if (_paramLength < MAX_PARAMS) {
+                        _params[_paramLength] = static_cast<char>(byte);
+                    }
+                    _paramLength++;
+                    continue;
+                }
+                _state = GROUND;
+                if (byte >= 0x40 && byte <= 0x7e) {
+                    decodeCsi(byte, event);
+                } else {
+                    event.kind = KeyEvent::UNKNOWN;
+                }
+                return true;
+
+            case SS3:
+                _state = GROUND;
+                _paramLength = 0;
+                decodeCsi(byte, event);
+                if (byte == '~') {
+                    event.kind = KeyEvent::UNKNOWN;
+                }
+                return true;
+        }
+    }
+
+    if (_state != GROUND && escapeRemainingMs() == 0) {
+        expireSequence(event);
+        return true;
+    }
+    return false;
+}
+
+void InputDecoder::expireSequence(KeyEvent& event) {
+    // Одиночный ESC - нажатие клавиши; оборванные ESC [ и ESC O не ждут завершающий байт вечно
+    event.kind = _state == ESC ? KeyEvent::ESCAPE : KeyEvent::UNKNOWN;
+    _state = GROUND;
+    _paramLength = 0;
+}
+
+bool InputDecoder::waitEvent(KeyEvent& event, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs < 0 ? 0 : timeoutMs);
+
+    while (true) {
+        if (next(event)) {
+            return true;
+        }
+
+        if (_eof) {
+            // Новых байт не будет: незавершенный ESC считается нажатием
+            if (_state != GROUND) {
+                expireSequence(event);
+                return true;
+            }
+            return false;
+        }
+
+        int wait = -1;
+        if (timeoutMs >= 0) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()
+            ).count();
+            wait = left > 0 ? static_cast<int>(left) : 0;
+        }
+
+        int escape = escapeRemainingMs();
+        bool waitingEscape = escape >= 0 && (wait < 0 || escape < wait);
+        if (waitingEscape) {
+            wait = escape;
+        }
+
+        struct pollfd descriptor = {_fd, POLLIN, 0};
+        int ready = poll(&descriptor, 1, wait);
+        if (ready < 0) {
+            if (errno == EINTR && timeoutMs < 0) {
+                continue;
+            }
+            return false;
+        }
+
+        if (ready > 0) {
+            if (fill() == 0 && !_eof) {
+                return false;
+            }
+            continue;
+        }
+
+        if (!waitingEscape) {
+            return false;
+        }
+    }
+}
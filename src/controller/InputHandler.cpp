@@ -1,8 +1,9 @@
 #include "controller/InputHandler.hpp"
+#include "controller/InputDecoder.hpp"
 #include <unistd.h>
 #include <cstdio>
 
-InputHandler::InputHandler(): _isNonCanonicalMode(false) {
+InputHandler::InputHandler(): _isNonCanonicalMode(false), _exitRequested(false) {
     tcgetattr(STDIN_FILENO, &_originalTermios);
 }
 
@@ -33,25 +34,31 @@ Direction InputHandler::getDirectionFromInput() {
         enableCanonicalMode();
     }
 
-    char input;
+    InputDecoder& decoder = InputDecoder::forStdin();
+    KeyEvent event;
+    _exitRequested = false;
     while (true) {
-        ssize_t bytesRead = read(STDIN_FILENO, &input, 1);
-        if (bytesRead > 0) {
-            if (input == '\033') {
-                Direction result;
-                if (handleEscapeSequence(result)) {
-                    return result;
-                } 
-            } 
-            
-            else if (isValidDirection(input)) {
-                return convertToDirection(input);
-            } 
-            
-            else if (input == ' ') {
+        if (!decoder.waitEvent(event, -1)) {
+            // Ввод закончился: повторное ожидание сразу вернет false и загрузит процессор
+            if (decoder.exhausted()) {
+                _exitRequested = true;
                 return Direction::NONE;
             }
+            continue;
+        }
+        if (event.pasted) {
+            continue;
+        }
 
+        if (event.direction() != Direction::NONE) {
+            return event.direction();
+        }
+        if (event.kind == KeyEvent::SPACE) {
+            return Direction::NONE;
+        }
+        if (event.kind == KeyEvent::ESCAPE) {
+            _exitRequested = true;
+            return Direction::NONE;
         }
     }
 }
@@ -63,31 +70,6 @@ bool InputHandler::isValidDirection(char input) const {
            input == 'd' || input == 'D';
 }
 
-bool InputHandler::handleEscapeSequence(Direction& result) const {
-    char seq[2];
-    if (read(STDIN_FILENO, &seq[0], 1) > 0) {
-        if (seq[0] == '[') {
-            if (read(STDIN_FILENO, &seq[1], 1) > 0) {
-                switch(seq[1]) {
-                    case 'A':
-                        result = Direction::UP;
-                        return true;
-                    case 'B':
-                        result = Direction::DOWN;
-                        return true;
-                    case 'C':
-                        result = Direction::RIGHT;
-                        return true;
-                    case 'D':
-                        result = Direction::LEFT;
-                        return true;
-                }
-            }
-        }
-    }
-    return false;
-}
-
 Direction InputHandler::convertToDirection(char input) const {
     switch (input) {
         case 'w': case 'W':
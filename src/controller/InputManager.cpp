@@ -1,4 +1,5 @@
 #include "controller/InputManager.hpp"
+#include "controller/InputDecoder.hpp"
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/select.h>
@@ -31,9 +32,9 @@ void InputManager::setNonBlockingMode(bool enable) {
 }
 
 char InputManager::getCharNonBlocking() {
-    char c = 0;
-    if (read(STDIN_FILENO, &c, 1) > 0) {
-        return c;
+    KeyEvent event;
+    if (InputDecoder::forStdin().waitEvent(event, 0) && event.ch != 0) {
+        return event.ch;
     }
     return 0;
 }
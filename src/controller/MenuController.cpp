@@ -1,5 +1,9 @@
 #include "controller/MenuController.hpp"
 #include "controller/InputHandler.hpp"
+#include "controller/InputDecoder.hpp"
+#include "view/TerminalGeometry.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/Tracer.hpp"
 #include <iostream>
 #include <unistd.h>
 #include <ctime>
@@ -8,28 +12,109 @@
 #include <algorithm>
 #include <cstdlib>
 #include <csignal>
-#include <sys/ioctl.h>
 #include <termios.h>
 
-MenuController* MenuController::globalMenuController = nullptr;
+const int MenuController::RESIZE_POLL_MS;
+volatile sig_atomic_t MenuController::_resizePending = 0;
 
 void MenuController::handleResize(int sig) {
-    if (globalMenuController && sig == SIGWINCH) {
-        static bool handlingResize = false;
-        if (handlingResize) return;
-        
-        handlingResize = true;
-        
-        if (!globalMenuController->_currentMenuItems.empty()) {
-            usleep(100000);
-            globalMenuController->refreshMenu();
+    // Только сигнально-безопасные действия: перерисовку делает цикл меню
+    TerminalGeometry::onResizeSignal(sig);
+    if (sig == SIGWINCH) {
+        _resizePending = 1;
+    }
+}
+
+bool MenuController::takePendingResize() {
+    if (!_resizePending) {
+        return false;
+    }
+    _resizePending = 0;
+    return true;
+}
+
+void GameState::capture(const GameModel& model) {
+    playerPosition = model.getPlayerPosition();
+    score = model.getScore();
+    
+    const Grid& grid = model.getGrid();
+    width = grid.getWidth();
+    height = grid.getHeight();
+    
+    int totalCells = width * height;
+    
+    cellValues.clear();
+    cellColors.clear();
+    cellAvailable.clear();
+    cellTypes.clear();
+    teleportTargetsX.clear();
+    teleportTargetsY.clear();
+    
+    cellValues.reserve(totalCells);
+    cellColors.reserve(totalCells);
+    cellAvailable.reserve(totalCells);
+    cellTypes.reserve(totalCells);
+    teleportTargetsX.reserve(totalCells);
+    teleportTargetsY.reserve(totalCells);
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            Position pos(x, y);
+            const ICell& cell = grid[pos];
+            
+            if (cell.getType() == CellType::TELEPORT) {
+                const TeleportCell* teleportCell = static_cast<const TeleportCell*>(&cell);
+                cellTypes.push_back(static_cast<int>(CellType::TELEPORT));
+                
+                Position tpPos = teleportCell->getTPPos();
+                teleportTargetsX.push_back(tpPos.getX());
+                teleportTargetsY.push_back(tpPos.getY());
+                
+                cellValues.push_back(0);
+                cellColors.push_back(static_cast<int>(Color::GREEN));
+            }
+            else if (cell.getType() == CellType::BOMB) {
+                cellTypes.push_back(static_cast<int>(CellType::BOMB));
+                teleportTargetsX.push_back(0);
+                teleportTargetsY.push_back(0);
+                
+                cellValues.push_back(0);
+                cellColors.push_back(static_cast<int>(Color::RED));
+            }
+            else {
+                const BasicCell* basicCell = static_cast<const BasicCell*>(&cell);
+                cellTypes.push_back(static_cast<int>(CellType::BASIC));
+                teleportTargetsX.push_back(0);
+                teleportTargetsY.push_back(0);
+                
+                cellValues.push_back(basicCell->getValue());
+                cellColors.push_back(static_cast<int>(basicCell->getColor()));
+            }
+            
+            cellAvailable.push_back(cell.isAvailable() ? 1 : 0);
         }
-        
-        handlingResize = false;
     }
 }
 
-void GameState::serialize(std::ofstream& file) const {
+bool GameState::restore(GameModel& model) const {
+    try {
+        model.initializeGameFromState(
+            cellValues,
+            cellColors,
+            cellAvailable,
+            cellTypes,
+            teleportTargetsX,
+            teleportTargetsY,
+            playerPosition,
+            score
+        );
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+void GameState::serialize(std::ostream& file) const {
     file.write(reinterpret_cast<const char*>(&playerPosition), sizeof(Position));
     file.write(reinterpret_cast<const char*>(&score), sizeof(int));
     file.write(reinterpret_cast<const char*>(&width), sizeof(int));
@@ -72,7 +157,7 @@ void GameState::serialize(std::ofstream& file) const {
     }
 }
 
-void GameState::deserialize(std::ifstream& file) {
+void GameState::deserialize(std::istream& file) {
     file.read(reinterpret_cast<char*>(&playerPosition), sizeof(Position));
     file.read(reinterpret_cast<char*>(&score), sizeof(int));
     file.read(reinterpret_cast<char*>(&width), sizeof(int));
@@ -129,26 +214,22 @@ MenuController::MenuController() : _playerName("Player"), _hasSavedGame(false),
     sigemptyset(&sa.sa_mask);
     sa.sa_flags = 0;
     sigaction(SIGWINCH, &sa, nullptr);
-    
-    globalMenuController = this;
 }
 
 bool MenuController::checkTerminalSize() const {
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-    return (w.ws_col >= 80 && w.ws_row >= 24);
+    TerminalSize w = TerminalGeometry::get();
+    return (w.columns >= 80 && w.rows >= 24);
 }
 
 void MenuController::displaySizeError() const {
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
+    TerminalSize w = TerminalGeometry::get();
     
     std::cout << "\033[2J\033[1;1H";
     std::string errorMsg = "Terminal size too small! Minimum: 80x24, Current: " + 
-                          std::to_string(w.ws_col) + "x" + std::to_string(w.ws_row);
+                          std::to_string(w.columns) + "x" + std::to_string(w.rows);
     
-    int errorX = (w.ws_col - errorMsg.length()) / 2;
-    int errorY = w.ws_row / 2;
+    int errorX = (w.columns - errorMsg.length()) / 2;
+    int errorY = w.rows / 2;
     
     if (errorX < 0) errorX = 0;
     if (errorY < 0) errorY = 0;
@@ -159,33 +240,23 @@ void MenuController::displaySizeError() const {
 }
 
 void MenuController::refreshMenu() {
-    struct sigaction sa_old, sa_new;
-    sa_new.sa_handler = SIG_IGN;
-    sigemptyset(&sa_new.sa_mask);
-    sa_new.sa_flags = 0;
-    sigaction(SIGWINCH, &sa_new, &sa_old);
-    
     if (!checkTerminalSize()) {
         displaySizeError();
-        sigaction(SIGWINCH, &sa_old, nullptr);
         return;
     }
     
     if (!_currentMenuItems.empty()) {
         displayMenuItems(_currentMenuItems, _currentSelectedIndex);
     }
-    
-    sigaction(SIGWINCH, &sa_old, nullptr);
 }
 
 
 void MenuController::drawAsciiTitle() {
     std::cout << "\033[2J\033[1;1H";
     
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-    int terminalWidth = w.ws_col;
-    int terminalHeight = w.ws_row;
+    TerminalSize w = TerminalGeometry::get();
+    int terminalWidth = w.columns;
+    int terminalHeight = w.rows;
     
     std::vector<std::string> titleLines = {
         " ######   ########  ########  ########  ######  ",
@@ -233,10 +304,9 @@ void MenuController::displayMenuItems(const std::vector<std::string>& items, int
     sigaddset(&mask, SIGWINCH);
     sigprocmask(SIG_BLOCK, &mask, &oldmask);
 
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-    int terminalWidth = w.ws_col;
-    int terminalHeight = w.ws_row;
+    TerminalSize w = TerminalGeometry::get();
+    int terminalWidth = w.columns;
+    int terminalHeight = w.rows;
     
     std::cout << "\033[2J\033[3J\033[1;1H";
     std::cout.flush();
@@ -447,10 +517,11 @@ void MenuController::displayMenuItems(const std::vector<std::string>& items, int
 }
 
 void MenuController::setPlayerName() {
+    GREED_TRACE_SCOPE("menu", "setPlayerName");
     struct sigaction sa;
     sigemptyset(&sa.sa_mask);
-    sa.sa_handler = SIG_IGN;
-    sa.sa_flags = 0;
+    sa.sa_handler = TerminalGeometry::onResizeSignal;
+    sa.sa_flags = SA_RESTART;
     sigaction(SIGWINCH, &sa, nullptr);
     
     struct termios oldt;
@@ -465,10 +536,9 @@ void MenuController::setPlayerName() {
     tcsetattr(STDIN_FILENO, TCSANOW, &newt);
     
     while (true) {
-        struct winsize w;
-        ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-        int terminalWidth = w.ws_col;
-        int terminalHeight = w.ws_row;
+        TerminalSize w = TerminalGeometry::get();
+        int terminalWidth = w.columns;
+        int terminalHeight = w.rows;
         
         if (terminalWidth < 80 || terminalHeight < 24) {
             std::cout << "\033[2J\033[3J\033[1;1H";
@@ -487,31 +557,18 @@ void MenuController::setPlayerName() {
             std::cout << "\033[33mResize terminal or press Enter to return...\033[0m";
             std::cout.flush();
             
-            fd_set readfds;
-            struct timeval timeout;
+            KeyEvent event;
             
             while (true) {
-                FD_ZERO(&readfds);
-                FD_SET(STDIN_FILENO, &readfds);
-                timeout.tv_sec = 0;
-                timeout.tv_usec = 100000;
-                
-                int ready = select(STDIN_FILENO + 1, &readfds, NULL, NULL, &timeout);
-                
-                if (ready > 0) {
-                    char buf[10];
-                    ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
-                    if (n > 0 && (buf[0] == '\n' || buf[0] == '\r')) {
-                        tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-                        sa.sa_handler = handleResize;
-                        sigaction(SIGWINCH, &sa, nullptr);
-                        return;
-                    }
+                if (InputDecoder::forStdin().waitEvent(event, 100) && event.kind == KeyEvent::ENTER) {
+                    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+                    sa.sa_handler = handleResize;
+                    sigaction(SIGWINCH, &sa, nullptr);
+                    return;
                 }
                 
-                struct winsize w2;
-                ioctl(STDOUT_FILENO, TIOCGWINSZ, &w2);
-                if (w2.ws_col != w.ws_col || w2.ws_row != w.ws_row) {
+                TerminalSize w2 = TerminalGeometry::get();
+                if (w2.columns != w.columns || w2.rows != w.rows) {
                     break;
                 }
             }
@@ -576,10 +633,11 @@ void MenuController::setPlayerName() {
 
 
 void MenuController::showRules() {
+    GREED_TRACE_SCOPE("menu", "showRules");
     struct sigaction sa;
     sigemptyset(&sa.sa_mask);
-    sa.sa_handler = SIG_IGN;
-    sa.sa_flags = 0;
+    sa.sa_handler = TerminalGeometry::onResizeSignal;
+    sa.sa_flags = SA_RESTART;
     sigaction(SIGWINCH, &sa, nullptr);
     
     struct termios oldt;
@@ -595,10 +653,9 @@ void MenuController::showRules() {
     bool shouldReturn = false;
     
     while (!shouldReturn) {
-        struct winsize w;
-        ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-        int terminalWidth = w.ws_col;
-        int terminalHeight = w.ws_row;
+        TerminalSize w = TerminalGeometry::get();
+        int terminalWidth = w.columns;
+        int terminalHeight = w.rows;
         
         if (terminalWidth < 80 || terminalHeight < 24) {
             std::cout << "\033[2J\033[3J\033[1;1H";
@@ -617,8 +674,8 @@ void MenuController::showRules() {
             std::cout << "\033[33mResize terminal or press any key to return...\033[0m";
             std::cout.flush();
             
-            char input;
-            read(STDIN_FILENO, &input, 1);
+            KeyEvent event;
+            InputDecoder::forStdin().waitEvent(event, -1);
             shouldReturn = true;
             break;
         }
@@ -680,28 +737,17 @@ void MenuController::showRules() {
         
         std::cout.flush();
         
-        fd_set readfds;
-        struct timeval timeout;
+        KeyEvent event;
         
         bool keyPressed = false;
         while (!keyPressed) {
-            FD_ZERO(&readfds);
-            FD_SET(STDIN_FILENO, &readfds);
-            timeout.tv_sec = 0;
-            timeout.tv_usec = 100000;
-            
-            int ready = select(STDIN_FILENO + 1, &readfds, NULL, NULL, &timeout);
-            
-            if (ready > 0) {
-                char input;
-                read(STDIN_FILENO, &input, 1);
+            if (InputDecoder::forStdin().waitEvent(event, 100)) {
                 shouldReturn = true;
                 keyPressed = true;
             }
             
-            struct winsize w2;
-            ioctl(STDOUT_FILENO, TIOCGWINSZ, &w2);
-            if (w2.ws_col != w.ws_col || w2.ws_row != w.ws_row) {
+            TerminalSize w2 = TerminalGeometry::get();
+            if (w2.columns != w.columns || w2.rows != w.rows) {
                 break;
             }
         }
@@ -771,10 +817,11 @@ void MenuController::addToLeaderboard(int score) {
     saveLeaderboard();
 }
 void MenuController::showLeaderboard() {
+    GREED_TRACE_SCOPE("menu", "showLeaderboard");
     struct sigaction sa;
     sigemptyset(&sa.sa_mask);
-    sa.sa_handler = SIG_IGN;
-    sa.sa_flags = 0;
+    sa.sa_handler = TerminalGeometry::onResizeSignal;
+    sa.sa_flags = SA_RESTART;
     sigaction(SIGWINCH, &sa, nullptr);
     
     struct termios oldt;
@@ -790,10 +837,9 @@ void MenuController::showLeaderboard() {
     bool shouldReturn = false;
     
     while (!shouldReturn) {
-        struct winsize w;
-        ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-        int terminalWidth = w.ws_col;
-        int terminalHeight = w.ws_row;
+        TerminalSize w = TerminalGeometry::get();
+        int terminalWidth = w.columns;
+        int terminalHeight = w.rows;
         
         if (terminalWidth < 80 || terminalHeight < 24) {
             std::cout << "\033[2J\033[3J\033[1;1H";
@@ -812,8 +858,8 @@ void MenuController::showLeaderboard() {
             std::cout << "\033[33mResize terminal or press any key to return...\033[0m";
             std::cout.flush();
             
-            char input;
-            read(STDIN_FILENO, &input, 1);
+            KeyEvent event;
+            InputDecoder::forStdin().waitEvent(event, -1);
             shouldReturn = true;
             break;
         }
@@ -872,28 +918,17 @@ void MenuController::showLeaderboard() {
         
         std::cout.flush();
         
-        fd_set readfds;
-        struct timeval timeout;
+        KeyEvent event;
         
         bool keyPressed = false;
         while (!keyPressed) {
-            FD_ZERO(&readfds);
-            FD_SET(STDIN_FILENO, &readfds);
-            timeout.tv_sec = 0;
-            timeout.tv_usec = 100000;
-            
-            int ready = select(STDIN_FILENO + 1, &readfds, NULL, NULL, &timeout);
-            
-            if (ready > 0) {
-                char input;
-                read(STDIN_FILENO, &input, 1);
+            if (InputDecoder::forStdin().waitEvent(event, 100)) {
                 shouldReturn = true;
                 keyPressed = true;
             }
             
-            struct winsize w2;
-            ioctl(STDOUT_FILENO, TIOCGWINSZ, &w2);
-            if (w2.ws_col != w.ws_col || w2.ws_row != w.ws_row) {
+            TerminalSize w2 = TerminalGeometry::get();
+            if (w2.columns != w.columns || w2.rows != w.rows) {
                 break;
             }
         }
@@ -909,72 +944,10 @@ void MenuController::showLeaderboard() {
 }
 
 void MenuController::saveGame(GameModel* model) {
+    GREED_TRACE_SCOPE("menu", "saveGame");
+    GREED_ALLOCATION_PHASE(SAVE);
     GameState state;
-    state.playerPosition = model->getPlayerPosition();
-    state.score = model->getScore();
-    
-    const Grid& grid = model->getGrid();
-    state.width = grid.getWidth();
-    state.height = grid.getHeight();
-    
-    int totalCells = state.width * state.height;
-    
-    state.cellValues.clear();
-    state.cellColors.clear();
-    state.cellAvailable.clear();
-    state.cellTypes.clear();
-    state.teleportTargetsX.clear();
-    state.teleportTargetsY.clear();
-    
-    state.cellValues.reserve(totalCells);
-    state.cellColors.reserve(totalCells);
-    state.cellAvailable.reserve(totalCells);
-    state.cellTypes.reserve(totalCells);
-    state.teleportTargetsX.reserve(totalCells);
-    state.teleportTargetsY.reserve(totalCells);
-    
-    for (int y = 0; y < state.height; y++) {
-        for (int x = 0; x < state.width; x++) {
-            Position pos(x, y);
-            const ICell& cell = grid[pos];
-            
-            if (dynamic_cast<const TeleportCell*>(&cell)) {
-                const TeleportCell* teleportCell = static_cast<const TeleportCell*>(&cell);
-                state.cellTypes.push_back(1);
-                
-                Position tpPos = teleportCell->getTPPos();
-                state.teleportTargetsX.push_back(tpPos.getX());
-                state.teleportTargetsY.push_back(tpPos.getY());
-                
-                state.cellValues.push_back(0);
-                state.cellColors.push_back(static_cast<int>(Color::GREEN));
-            }
-            else if (dynamic_cast<const BombCell*>(&cell)) {
-                state.cellTypes.push_back(2);
-                state.teleportTargetsX.push_back(0);
-                state.teleportTargetsY.push_back(0);
-                
-                state.cellValues.push_back(0);
-                state.cellColors.push_back(static_cast<int>(Color::RED));
-            }
-            else {
-                const BasicCell* basicCell = dynamic_cast<const BasicCell*>(&cell);
-                state.cellTypes.push_back(0);
-                state.teleportTargetsX.push_back(0);
-                state.teleportTargetsY.push_back(0);
-                
-                if (basicCell) {
-                    state.cellValues.push_back(basicCell->getValue());
-                    state.cellColors.push_back(static_cast<int>(basicCell->getColor()));
-                } else {
-                    state.cellValues.push_back(0);
-                    state.cellColors.push_back(0);
-                }
-            }
-            
-            state.cellAvailable.push_back(cell.isAvailable() ? 1 : 0);
-        }
-    }
+    state.capture(*model);
     
     std::ofstream file(SAVE_FILE, std::ios::binary);
     if (file.is_open()) {
@@ -993,13 +966,14 @@ void MenuController::saveGame(GameModel* model) {
 
 
 bool MenuController::runMainMenu() {
+    GREED_TRACE_SCOPE("menu", "mainMenu");
     std::cout << "\033[?1049h\033[2J\033[1;1H";
     std::cout.flush();
 
     std::cout << "\033[?1049h";
     std::cout << "\033[?7l";
 
-    globalMenuController = this;
+    takePendingResize();
     
     struct sigaction sa_old;
     struct sigaction sa_new;
@@ -1039,54 +1013,46 @@ bool MenuController::runMainMenu() {
     
     displayMenuItems(menuItems, selectedIndex);
     
+    InputDecoder& decoder = InputDecoder::forStdin();
+    
     while (true) {
-        char input;
+        KeyEvent event;
         struct termios oldt, newt;
         tcgetattr(STDIN_FILENO, &oldt);
         newt = oldt;
         newt.c_lflag &= ~(ICANON | ECHO);
         tcsetattr(STDIN_FILENO, TCSANOW, &newt);
         
-        ssize_t bytesRead = read(STDIN_FILENO, &input, 1);
+        bool received = decoder.waitEvent(event, RESIZE_POLL_MS);
         
         tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
         
-        if (bytesRead > 0) {
-            if (input == '\033') {
-                char seq[2];
-                
-                tcgetattr(STDIN_FILENO, &oldt);
-                newt = oldt;
-                newt.c_lflag &= ~(ICANON | ECHO);
-                tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-                
-                if (read(STDIN_FILENO, &seq[0], 1) > 0) {
-                    if (seq[0] == '[') {
-                        if (read(STDIN_FILENO, &seq[1], 1) > 0) {
-                            if (seq[1] == 'A') {
-                                selectedIndex = (selectedIndex - 1 + menuItems.size()) % menuItems.size();
-                                displayMenuItems(menuItems, selectedIndex);
-                            } else if (seq[1] == 'B') { 
-                                selectedIndex = (selectedIndex + 1) % menuItems.size();
-                                displayMenuItems(menuItems, selectedIndex);
-                            }
-                        }
-                    }
-                }
-                
-                tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-            } 
-            else if (input == '\n' || input == '\r' || input == ' ') { 
+        if (takePendingResize()) {
+            refreshMenu();
+        }
+        
+        if (received && !event.pasted) {
+            if (event.kind == KeyEvent::UP) {
+                selectedIndex = (selectedIndex - 1 + menuItems.size()) % menuItems.size();
+                displayMenuItems(menuItems, selectedIndex);
+            }
+            else if (event.kind == KeyEvent::DOWN) {
+                selectedIndex = (selectedIndex + 1) % menuItems.size();
+                displayMenuItems(menuItems, selectedIndex);
+            }
+            else if (event.kind == KeyEvent::ENTER || event.kind == KeyEvent::SPACE) { 
                 _lastSelectedOption = selectedIndex;
                 
                 switch(selectedIndex) {
                     case 0: // Start New Game
+                        GREED_TRACE_INSTANT("menu", "startGame");
                         std::cout << "\033[?7h";
                         std::cout << "\033[?1049l";
                         return true;
                         break;
                     case 1:// Load Saved Game
                         if (_hasSavedGame) {
+                            GREED_TRACE_INSTANT("menu", "loadSavedGame");
                             std::cout << "\033[?7h";
                             std::cout << "\033[?1049l";
                             return true;
@@ -1128,7 +1094,7 @@ bool MenuController::runMainMenu() {
                 
                 displayMenuItems(menuItems, selectedIndex);
             }
-            else if (input == 'q' || input == 27) {
+            else if (event.key() == 'q' || event.kind == KeyEvent::ESCAPE) {
                 std::cout << "\033[?7h";
                 std::cout << "\033[?1049l";
                 system("clear");
@@ -1143,11 +1109,12 @@ bool MenuController::runMainMenu() {
     std::cout << "\033[?7h";
     std::cout << "\033[?1049l";
     system("clear");
-    globalMenuController = nullptr;
     return false;
 }
 
 bool MenuController::loadGame(GameModel* model) {
+    GREED_TRACE_SCOPE("menu", "loadGame");
+    GREED_ALLOCATION_PHASE(SAVE);
     std::ifstream loadFile(SAVE_FILE, std::ios::binary);
     if (!loadFile.is_open()) {
         return false;
@@ -1157,32 +1124,18 @@ bool MenuController::loadGame(GameModel* model) {
     state.deserialize(loadFile);
     loadFile.close();
     
-    try {
-        model->initializeGameFromState(
-            state.cellValues,
-            state.cellColors,
-            state.cellAvailable,
-            state.cellTypes,
-            state.teleportTargetsX,
-            state.teleportTargetsY,
-            state.playerPosition,
-            state.score
-        );
-        return true;
-    } catch (...) {
-        return false;
-    }
+    return state.restore(*model);
 }
 
 void MenuController::showWelcomeScreen() {
+    GREED_TRACE_SCOPE("menu", "showWelcomeScreen");
     std::cout << "\033[?1049h";
     std::cout << "\033[?7l"; 
     std::cout << "\033[2J\033[1;1H";
     
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-    int terminalWidth = w.ws_col;
-    int terminalHeight = w.ws_row;
+    TerminalSize w = TerminalGeometry::get();
+    int terminalWidth = w.columns;
+    int terminalHeight = w.rows;
     
     drawAsciiTitle();
     
@@ -1196,8 +1149,8 @@ void MenuController::showWelcomeScreen() {
     newt.c_lflag &= ~(ICANON | ECHO);
     tcsetattr(STDIN_FILENO, TCSANOW, &newt);
     
-    char input;
-    read(STDIN_FILENO, &input, 1);
+    KeyEvent event;
+    InputDecoder::forStdin().waitEvent(event, -1);
     
     tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
 }
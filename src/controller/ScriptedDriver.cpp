@@ -0,0 +1,173 @@
+#include "controller/ScriptedDriver.hpp"
+#include "controller/GameController.hpp"
+#include "controller/InputDecoder.hpp"
+#include "core/AllocationTracker.hpp"
+#include "model/GameModel.hpp"
+#include "view/CountingSink.hpp"
+#include "view/GameView.hpp"
+#include "view/VirtualTerminal.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <unistd.h>
+
+const int ScriptedDriver::DEFAULT_COLUMNS;
+const int ScriptedDriver::DEFAULT_ROWS;
+const int ScriptedDriver::WARMUP_MOVES;
+
+namespace {
+
+/**
+ * @brief Возвращает число выделений в фазах хода и отрисовки
+ */
+AllocationTracker::Counters loopAllocations() {
+    AllocationTracker::Counters move = AllocationTracker::get(AllocationTracker::MOVE);
+    AllocationTracker::Counters render = AllocationTracker::get(AllocationTracker::RENDER);
+    move.allocations += render.allocations;
+    move.bytes += render.bytes;
+    return move;
+}
+
+} // namespace
+
+long long ScriptReport::latencyPercentile(double percent) const {
+    if (moveLatencyNs.empty()) {
+        return 0;
+    }
+
+    std::vector<long long> sorted(moveLatencyNs);
+    size_t index = static_cast<size_t>(percent / 100.0 * (sorted.size() - 1) + 0.5);
+    index = std::min(index, sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+ScriptedDriver::ScriptedDriver(int width, int height, unsigned int seed, TerminalSize terminal):
+    _width(width), _height(height), _seed(seed), _terminal(terminal), _verifyScreens(false) {}
+
+void ScriptedDriver::setVerifyScreens(bool verify) {
+    _verifyScreens = verify;
+}
+
+ScriptReport ScriptedDriver::run(const std::string& keys) const {
+    FILE* script = std::tmpfile();
+    if (!script) {
+        throw std::runtime_error("Failed to create script file | ScriptedDriver::run()");
+    }
+
+    std::fwrite(keys.data(), 1, keys.size(), script);
+    std::fflush(script);
+    std::rewind(script);
+
+    try {
+        ScriptReport report = runDescriptor(fileno(script));
+        std::fclose(script);
+        return report;
+    } catch (...) {
+        std::fclose(script);
+        throw;
+    }
+}
+
+ScriptReport ScriptedDriver::runFile(const std::string& path) const {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open script " + path + " | ScriptedDriver::runFile()");
+    }
+
+    try {
+        ScriptReport report = runDescriptor(fd);
+        close(fd);
+        return report;
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+}
+
+ScriptReport ScriptedDriver::runDescriptor(int fd) const {
+    ScriptReport report;
+    std::unique_ptr<CountingSink> output;
+    if (_verifyScreens) {
+        output = std::make_unique<VirtualTerminal>(_terminal.columns, _terminal.rows);
+    } else {
+        output = std::make_unique<CountingSink>();
+    }
+    CountingSink& sink = *output;
+
+    std::cout.flush();
+    std::streambuf* terminal = std::cout.rdbuf(&sink);
+    TerminalGeometry::setFixedSize(_terminal);
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        InputDecoder input(fd);
+        GameModel model(_width, _height, _seed);
+        GameView view(&model);
+        GameController controller(&model, &view);
+        unsigned long long bytesBefore = 0;
+        AllocationTracker::Counters allocationsBefore;
+
+        controller.setInputDecoder(&input);
+        controller.setMoveCallback([&](std::chrono::steady_clock::time_point keyTime) {
+            view.waitForIdle();
+            auto presented = std::chrono::steady_clock::now();
+
+            report.moveLatencyNs.push_back(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(presented - keyTime).count()
+            );
+            report.moveBytes.push_back(sink.getBytes() - bytesBefore);
+            bytesBefore = sink.getBytes();
+            report.moves++;
+
+            // Учитывается все от конца прошлого обратного вызова: подсветка, ход и его кадр
+            AllocationTracker::Counters allocations = loopAllocations();
+            if (report.moves > WARMUP_MOVES) {
+                report.steadyMoves++;
+                report.steadyAllocations += allocations.allocations - allocationsBefore.allocations;
+                report.steadyBytes += allocations.bytes - allocationsBefore.bytes;
+            }
+
+            // Ход, завершивший игру, перекрывается подсветкой конца игры и не сравнивается
+            if (_verifyScreens && !model.isGameOver()) {
+                // Полная перерисовка в отдельный терминал должна дать тот же экран
+                VirtualTerminal repaint(_terminal.columns, _terminal.rows);
+                std::cout.flush();
+                std::cout.rdbuf(&repaint);
+                view.refresh();
+                view.waitForIdle();
+                std::cout.flush();
+                std::cout.rdbuf(&sink);
+
+                report.repaintBytes.push_back(repaint.getBytes());
+                report.screenChecks++;
+                if (!static_cast<VirtualTerminal&>(sink).sameScreen(repaint)) {
+                    report.screenMismatches++;
+                }
+            }
+            allocationsBefore = loopAllocations();
+        });
+
+        controller.startGame();
+
+        report.score = model.getScore();
+        report.gameOver = model.isGameOver();
+    } catch (...) {
+        std::cout.rdbuf(terminal);
+        TerminalGeometry::releaseFixedSize();
+        throw;
+    }
+    report.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout.flush();
+    std::cout.rdbuf(terminal);
+    TerminalGeometry::releaseFixedSize();
+
+    report.totalBytes = sink.getBytes();
+    report.totalWrites = sink.getWrites();
+    return report;
+}
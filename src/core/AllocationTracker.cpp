@@ -0,0 +1,95 @@
+#include "core/AllocationTracker.hpp"
+#include <cstdlib>
+#include <new>
+
+#ifdef GREED_ALLOCATION_HOOK
+const bool AllocationTracker::HOOKED = true;
+#else
+const bool AllocationTracker::HOOKED = false;
+#endif
+
+std::atomic<unsigned long long> AllocationTracker::_allocations[AllocationTracker::PHASE_COUNT];
+std::atomic<unsigned long long> AllocationTracker::_bytes[AllocationTracker::PHASE_COUNT];
+thread_local AllocationTracker::Phase AllocationTracker::_phase = AllocationTracker::OTHER;
+
+AllocationTracker::Counters AllocationTracker::get(Phase phase) {
+    Counters counters;
+    counters.allocations = _allocations[phase].load(std::memory_order_relaxed);
+    counters.bytes = _bytes[phase].load(std::memory_order_relaxed);
+    return counters;
+}
+
+AllocationTracker::Counters AllocationTracker::total() {
+    Counters counters;
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        Counters phase = get(static_cast<Phase>(i));
+        counters.allocations += phase.allocations;
+        counters.bytes += phase.bytes;
+    }
+    return counters;
+}
+
+const char* AllocationTracker::phaseName(Phase phase) {
+    switch (phase) {
+        case OTHER:
+            return "other";
+        case GENERATION:
+            return "generation";
+        case MOVE:
+            return "move";
+        case RENDER:
+            return "render";
+        case SAVE:
+            return "save";
+        default:
+            return "unknown";
+    }
+}
+
+#ifdef GREED_ALLOCATION_HOOK
+namespace {
+
+void* trackedAllocate(size_t size) {
+    AllocationTracker::recordAllocation(size);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* trackedAllocateAligned(size_t size, size_t alignment) {
+    AllocationTracker::recordAllocation(size);
+    size_t rounded = (size + alignment - 1) / alignment * alignment;
+    void* memory = std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+} // namespace
+
+void* operator new(size_t size) { return trackedAllocate(size); }
+void* operator new[](size_t size) { return trackedAllocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return trackedAllocateAligned(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return trackedAllocateAligned(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAllocate(size); } catch (...) { return nullptr; }
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { std::free(memory); }
+#endif
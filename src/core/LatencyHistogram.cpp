@@ -0,0 +1,89 @@
+#include "core/LatencyHistogram.hpp"
+
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const int LatencyHistogram::SUB_BUCKETS;
+const int LatencyHistogram::MAX_VALUE_BITS;
+const size_t LatencyHistogram::BUCKET_COUNT;
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        _counts[i].store(0, std::memory_order_relaxed);
+    }
+    _total.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    const uint64_t limit = uint64_t(1) << MAX_VALUE_BITS;
+    if (value >= limit) {
+        value = limit - 1;
+    }
+    if (value < 2 * SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+
+    int bits = 0;
+    while ((value >> bits) != 0) {
+        bits++;
+    }
+    // Старшие SUB_BUCKET_BITS + 1 бит значения: номер корзины внутри степени двойки
+    int shift = bits - (SUB_BUCKET_BITS + 1);
+    return 2 * SUB_BUCKETS + (shift - 1) * SUB_BUCKETS + static_cast<size_t>((value >> shift) - SUB_BUCKETS);
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+
+    size_t shift = (index - 2 * SUB_BUCKETS) / SUB_BUCKETS + 1;
+    uint64_t sub = (index - 2 * SUB_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+    return sub << shift;
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds) {
+    _counts[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    _total.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    uint64_t current = _max.load(std::memory_order_relaxed);
+    while (nanoseconds > current && !_max.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::getMean() const {
+    uint64_t count = getCount();
+    return count == 0 ? 0 : _sum.load(std::memory_order_relaxed) / count;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+    uint64_t count = getCount();
+    if (count == 0) {
+        return 0;
+    }
+
+    double rank = percent / 100.0 * static_cast<double>(count);
+    uint64_t target = static_cast<uint64_t>(rank);
+    if (static_cast<double>(target) < rank) {
+        target++;
+    }
+    if (target < 1) {
+        target = 1;
+    }
+
+    uint64_t max = getMax();
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += getBucketCount(i);
+        if (seen >= target) {
+            uint64_t upper = bucketUpperBound(i);
+            return upper < max ? upper : max;
+        }
+    }
+    return max;
+}
@@ -0,0 +1,116 @@
+#include "core/Tracer.hpp"
+#include <fstream>
+#include <iomanip>
+
+const size_t Tracer::CAPACITY;
+const int Tracer::MAX_THREADS;
+
+std::atomic<bool> Tracer::_enabled(false);
+std::unique_ptr<Tracer::Event[]> Tracer::_events;
+std::atomic<uint64_t> Tracer::_next(0);
+std::atomic<uint32_t> Tracer::_threads(0);
+std::atomic<const char*> Tracer::_threadNames[Tracer::MAX_THREADS];
+std::chrono::steady_clock::time_point Tracer::_origin;
+std::string Tracer::_path;
+
+void Tracer::start(const std::string& path) {
+    if (isEnabled()) {
+        return;
+    }
+
+    if (!_events) {
+        _events.reset(new Event[CAPACITY]());
+    }
+    _path = path;
+    _next.store(0, std::memory_order_relaxed);
+    _origin = std::chrono::steady_clock::now();
+    _enabled.store(true, std::memory_order_release);
+}
+
+uint32_t Tracer::threadId() {
+    thread_local uint32_t id = _threads.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void Tracer::setThreadName(const char* name) {
+    uint32_t id = threadId();
+    if (id < static_cast<uint32_t>(MAX_THREADS)) {
+        _threadNames[id].store(name, std::memory_order_relaxed);
+    }
+}
+
+void Tracer::push(const char* category, const char* name, std::chrono::steady_clock::time_point begin,
+    uint64_t duration, bool isInstant) {
+    long long start = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - _origin).count();
+
+    Event& event = _events[_next.fetch_add(1, std::memory_order_relaxed) & (CAPACITY - 1)];
+    event.category = category;
+    event.name = name;
+    event.start = start > 0 ? static_cast<uint64_t>(start) : 0;
+    event.duration = duration;
+    event.thread = threadId();
+    event.instant = isInstant;
+}
+
+void Tracer::record(const char* category, const char* name,
+    std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    long long duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    push(category, name, begin, duration > 0 ? static_cast<uint64_t>(duration) : 0, false);
+}
+
+void Tracer::instant(const char* category, const char* name) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    push(category, name, std::chrono::steady_clock::now(), 0, true);
+}
+
+bool Tracer::stop() {
+    if (!_enabled.exchange(false)) {
+        return false;
+    }
+
+    std::ofstream file(_path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Имена - строковые литералы из кода, экранирование JSON не нужно
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"greed_game\"}}";
+
+    uint32_t threads = _threads.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < threads && i < static_cast<uint32_t>(MAX_THREADS); i++) {
+        const char* name = _threadNames[i].load(std::memory_order_relaxed);
+        if (name != nullptr) {
+            file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+                 << ",\"args\":{\"name\":\"" << name << "\"}}";
+        }
+    }
+
+    uint64_t recorded = _next.load(std::memory_order_acquire);
+    uint64_t first = recorded > CAPACITY ? recorded - CAPACITY : 0;
+    for (uint64_t i = first; i < recorded; i++) {
+        const Event& event = _events[i & (CAPACITY - 1)];
+        if (event.name == nullptr) {
+            // Слот занят, но еще не заполнен потоком, который пишет прямо сейчас
+            continue;
+        }
+        file << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category << "\",";
+        if (event.instant) {
+            file << "\"ph\":\"i\",\"s\":\"t\",\"ts\":" << event.start / 1e3;
+        } else {
+            file << "\"ph\":\"X\",\"ts\":" << event.start / 1e3 << ",\"dur\":" << event.duration / 1e3;
+        }
+        file << ",\"pid\":1,\"tid\":" << event.thread << "}";
+    }
+
+    file << "\n],\"otherData\":{\"recorded\":" << recorded << ",\"overwritten\":" << first << "}}\n";
+    return file.good();
+}
@@ -5,10 +5,18 @@
 #include <unistd.h>
 #include <termios.h>
 #include "model/GameModel.hpp"
+#include "model/FairBoardGenerator.hpp"
 #include "view/GameView.hpp"
 #include "controller/GameController.hpp"
 #include "controller/MenuController.hpp"
+#include "controller/ScriptedDriver.hpp"
+#include "view/LatencyMonitor.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/Tracer.hpp"
 #include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <string>
 
 struct termios originalTermios;
 
@@ -20,9 +28,176 @@ void sigintHandler(int sig) {
     std::exit(0);
 }
 
-int main() {
+/**
+ * @brief Записывает задержки ходов за сеанс в файл
+ * @note Путь берется из GREED_LATENCY_FILE (по умолчанию latency.txt); без ходов файл не создается
+ */
+void dumpLatency() {
+    LatencyMonitor& latency = LatencyMonitor::instance();
+    if (latency.get(LatencyMonitor::TOTAL).getCount() == 0) {
+        return;
+    }
+
+    const char* path = std::getenv("GREED_LATENCY_FILE");
+    latency.dump(path != nullptr && path[0] != '\0' ? path : "latency.txt");
+}
+
+/**
+ * @brief Записывает трассу, если трассировка включена
+ */
+void writeTrace() {
+    Tracer::stop();
+}
+
+/**
+ * @brief Включает трассировку по флагу --trace FILE или переменной GREED_TRACE
+ * @param argc Количество аргументов
+ * @param argv Аргументы
+ */
+void startTracing(int argc, char* argv[]) {
+    const char* path = std::getenv("GREED_TRACE");
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--trace") == 0) {
+            path = argv[i + 1];
+        }
+    }
+    if (path == nullptr || path[0] == '\0') {
+        return;
+    }
+
+#ifndef GREED_TRACING
+    std::cerr << "Tracing is compiled out of this build; " << path << " will contain no spans" << std::endl;
+#endif
+    Tracer::start(path);
+    GREED_TRACE_THREAD("main");
+    std::atexit(writeTrace);
+}
+
+/**
+ * @brief Создает модель новой партии на "честном" поле (турнирный режим, флаг --fair)
+ * @return Модель на поле, найденном FairBoardGenerator от текущего времени
+ * @note Если за бюджет генератора подходящее поле не найдено, берется лучшее из проверенных
+ */
+GameModel* createFairModel() {
+    const int size = 25;
+    FairBoardResult fair = FairBoardGenerator().generate(size, size, static_cast<unsigned int>(time(NULL)), BoardConstraints());
+    return new GameModel(size, size, fair.seed);
+}
+
+/**
+ * @brief Прогоняет сценарий клавиш без терминала и печатает замеры
+ * @param argc Количество аргументов
+ * @param argv Аргументы: --script FILE [--seed N] [--size N] [--verify] [--alloc-check] [--trace FILE]
+ * @return Код завершения: 2 - экран разошелся с перерисовкой, 3 - ходы после прогрева выделяли память
+ */
+int runScript(int argc, char* argv[]) {
+    std::string path;
+    unsigned int seed = 1;
+    int size = 25;
+
+    bool verify = false;
+    bool allocationCheck = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--verify") == 0) {
+            verify = true;
+        } else if (std::strcmp(argv[i], "--alloc-check") == 0) {
+            allocationCheck = true;
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--script") == 0) {
+            path = argv[++i];
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--seed") == 0) {
+            seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--size") == 0) {
+            size = std::stoi(argv[++i]);
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--trace") == 0) {
+            i++; // Трассировка уже включена в main
+        }
+    }
+
+    if (allocationCheck && !AllocationTracker::HOOKED) {
+        std::cerr << "Error: --alloc-check needs a build configured with -DGREED_TRACK_ALLOCATIONS=ON" << std::endl;
+        return 1;
+    }
+
+    try {
+        ScriptedDriver driver(size, size, seed);
+        driver.setVerifyScreens(verify);
+        ScriptReport report = driver.runFile(path);
+
+        unsigned long long moveBytes = 0;
+        for (unsigned long long bytes: report.moveBytes) {
+            moveBytes += bytes;
+        }
+
+        std::cout << "moves: " << report.moves << "\n";
+        std::cout << "score: " << report.score << (report.gameOver ? " (game over)" : "") << "\n";
+        std::cout << "elapsed_ms: " << report.elapsedMs << "\n";
+        std::cout << "latency_p50_us: " << report.latencyPercentile(50) / 1000.0 << "\n";
+        std::cout << "latency_p99_us: " << report.latencyPercentile(99) / 1000.0 << "\n";
+        std::cout << "latency_max_us: " << report.latencyPercentile(100) / 1000.0 << "\n";
+        std::cout << "bytes_total: " << report.totalBytes << "\n";
+        std::cout << "bytes_per_move: " << (report.moves > 0 ? moveBytes / report.moves : 0) << "\n";
+        std::cout << "writes_total: " << report.totalWrites << "\n";
+        for (int i = 0; i < LatencyMonitor::PHASE_COUNT; i++) {
+            LatencyMonitor::Phase phase = static_cast<LatencyMonitor::Phase>(i);
+            const LatencyHistogram& histogram = LatencyMonitor::instance().get(phase);
+            std::cout << "phase_" << LatencyMonitor::phaseName(phase) << "_p50_p99_us: "
+                      << histogram.percentile(50) / 1000.0 << " " << histogram.percentile(99) / 1000.0 << "\n";
+        }
+        if (verify) {
+            unsigned long long repaintBytes = 0;
+            for (unsigned long long bytes: report.repaintBytes) {
+                repaintBytes += bytes;
+            }
+            std::cout << "bytes_per_repaint: " << (report.screenChecks > 0 ? repaintBytes / report.screenChecks : 0) << "\n";
+            std::cout << "screen_mismatches: " << report.screenMismatches << "/" << report.screenChecks << "\n";
+        }
+        if (AllocationTracker::HOOKED) {
+            for (int i = 0; i < AllocationTracker::PHASE_COUNT; i++) {
+                AllocationTracker::Phase phase = static_cast<AllocationTracker::Phase>(i);
+                AllocationTracker::Counters counters = AllocationTracker::get(phase);
+                std::cout << "allocs_" << AllocationTracker::phaseName(phase) << ": "
+                          << counters.allocations << " (" << counters.bytes << " bytes)\n";
+            }
+            std::cout << "allocs_per_move_steady: "
+                      << (report.steadyMoves > 0 ? static_cast<double>(report.steadyAllocations) / report.steadyMoves : 0.0)
+                      << " (" << report.steadyAllocations << " over " << report.steadyMoves << " moves)\n";
+        }
+        std::cout.flush();
+        if (report.screenMismatches > 0) {
+            return 2;
+        }
+        if (allocationCheck && report.steadyAllocations > 0) {
+            std::cerr << "Steady-state moves allocated " << report.steadyAllocations << " times ("
+                      << report.steadyBytes << " bytes)" << std::endl;
+            return 3;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    startTracing(argc, argv);
+
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--script") == 0) {
+            return runScript(argc, argv);
+        }
+    }
+
+    bool fairBoards = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--fair") == 0) {
+            fairBoards = true;
+        }
+    }
+
     tcgetattr(STDIN_FILENO, &originalTermios);
     std::signal(SIGINT, sigintHandler);
+    std::atexit(dumpLatency);
     std::cout << "\033[?7l";
     std::cout.flush();
 
@@ -39,7 +214,7 @@ int main() {
                 std::cout << "\033[2J\033[1;1H";
                 std::cout.flush();
                 
-                GameModel* model = new GameModel();
+                GameModel* model = fairBoards ? createFairModel() : new GameModel();
                 std::cout << "\033[?1049l\033[2J\033[1;1H";
                 std::cout.flush();
                 
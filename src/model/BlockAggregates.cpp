@@ -0,0 +1,106 @@
+#include "model/BlockAggregates.hpp"
+#include "model/Grid.hpp"
+#include "model/cells/BasicCell.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+const int BlockAggregates::MAX_BLOCKS;
+const int BlockAggregates::ESTIMATED_CELL_VALUE;
+
+BlockAggregates::BlockAggregates(): _blockSize(1), _blocksX(0), _blocksY(0), _bombsLeft(0) {}
+
+void BlockAggregates::build(const Grid& grid) {
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    int longest = std::max(width, height);
+
+    _blockSize = std::max(1, (longest + MAX_BLOCKS - 1) / MAX_BLOCKS);
+    _blocksX = (width + _blockSize - 1) / _blockSize;
+    _blocksY = (height + _blockSize - 1) / _blockSize;
+    _blocks.assign(static_cast<size_t>(_blocksX) * _blocksY, BlockStats{0, 0, 0, 0});
+    _dirty.clear();
+    // Каждый блок попадает в список не больше одного раза: поглощение клеток не расширяет его
+    _dirty.reserve(_blocks.size());
+    _isDirty.assign(_blocks.size(), 0);
+    _bombsLeft = 0;
+
+    if (grid.isChunked()) {
+        for (int by = 0; by < _blocksY; by++) {
+            for (int bx = 0; bx < _blocksX; bx++) {
+                long long blockWidth = std::min(_blockSize, width - bx * _blockSize);
+                long long blockHeight = std::min(_blockSize, height - by * _blockSize);
+                long long cells = blockWidth * blockHeight;
+
+                BlockStats& stats = _blocks[by * _blocksX + bx];
+                stats.cellsLeft = cells;
+                stats.bombsLeft = cells / 12;
+                stats.initialValue = (cells - stats.bombsLeft) * ESTIMATED_CELL_VALUE;
+                stats.remainingValue = stats.initialValue;
+                _bombsLeft += stats.bombsLeft;
+            }
+        }
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const ICell& cell = grid[Position(x, y)];
+            if (!cell.isAvailable()) {
+                continue;
+            }
+
+            BlockStats& stats = _blocks[(y / _blockSize) * _blocksX + x / _blockSize];
+            stats.cellsLeft++;
+            if (cell.getType() == CellType::BASIC) {
+                stats.initialValue += static_cast<const BasicCell&>(cell).getValue();
+            } else if (cell.getType() == CellType::BOMB) {
+                stats.bombsLeft++;
+                _bombsLeft++;
+            }
+        }
+    }
+
+    for (BlockStats& stats: _blocks) {
+        stats.remainingValue = stats.initialValue;
+    }
+}
+
+void BlockAggregates::consume(const Position& position, CellType type, int value) {
+    if (_blocks.empty()) {
+        return;
+    }
+
+    int index = (position.getY() / _blockSize) * _blocksX + position.getX() / _blockSize;
+    BlockStats& stats = _blocks[index];
+
+    stats.cellsLeft = std::max(0LL, stats.cellsLeft - 1);
+    if (type == CellType::BASIC) {
+        stats.remainingValue = std::max(0LL, stats.remainingValue - value);
+    } else if (type == CellType::BOMB && stats.bombsLeft > 0) {
+        stats.bombsLeft--;
+        _bombsLeft--;
+    }
+
+    if (!_isDirty[index]) {
+        _isDirty[index] = 1;
+        _dirty.push_back(index);
+    }
+}
+
+const BlockStats& BlockAggregates::at(int blockX, int blockY) const {
+    if (blockX < 0 || blockX >= _blocksX || blockY < 0 || blockY >= _blocksY) {
+        throw std::out_of_range("Block out of range | BlockAggregates::at()");
+    }
+    return _blocks[blockY * _blocksX + blockX];
+}
+
+Position BlockAggregates::blockOf(const Position& position) const {
+    return Position(position.getX() / _blockSize, position.getY() / _blockSize);
+}
+
+void BlockAggregates::clearDirty() {
+    for (int index: _dirty) {
+        _isDirty[index] = 0;
+    }
+    _dirty.clear();
+}
@@ -0,0 +1,351 @@
+#include "model/BoardAnalyzer.hpp"
+#include "model/cells/BasicCell.hpp"
+#include "model/cells/BombCell.hpp"
+#include "model/cells/TeleportCell.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+namespace {
+
+const Direction MOVE_DIRECTIONS[4] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+const int STEP_X[4] = {0, 0, -1, 1};
+const int STEP_Y[4] = {-1, 1, 0, 0};
+
+}
+
+BoardAnalyzer::BoardAnalyzer(): _width(0), _height(0) {}
+
+BoardReport BoardAnalyzer::analyze(const Grid& grid) {
+    return analyze(grid, Position(grid.getWidth() / 2, grid.getHeight() / 2));
+}
+
+BoardReport BoardAnalyzer::analyze(const Grid& grid, const Position& start) {
+    takeSnapshot(grid);
+
+    BoardReport report;
+    int startIndex = indexOf(start.getX(), start.getY());
+    if (startIndex < 0) {
+        return report;
+    }
+    _available[startIndex] = 0;
+
+    for (size_t i = 0; i < _kinds.size(); i++) {
+        if (!_available[i]) continue;
+        report.availableCells++;
+        if (_kinds[i] == BOMB) report.bombs++;
+    }
+
+    computeReachability(startIndex, report);
+    summarizeTeleports(startIndex, report);
+    greedyPlayout(startIndex, report);
+
+    return report;
+}
+
+std::vector<BoardReport> BoardAnalyzer::analyzeBoards(const std::vector<const Grid*>& grids, unsigned int threadCount) {
+    std::vector<BoardReport> reports(grids.size());
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min<unsigned int>(threadCount, static_cast<unsigned int>(grids.size()));
+
+    std::atomic<size_t> nextBoard(0);
+    auto worker = [&]() {
+        BoardAnalyzer analyzer;
+        for (size_t i = nextBoard++; i < grids.size(); i = nextBoard++) {
+            reports[i] = analyzer.analyze(*grids[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return reports;
+}
+
+void BoardAnalyzer::takeSnapshot(const Grid& grid) {
+    _width = grid.getWidth();
+    _height = grid.getHeight();
+    size_t totalCells = static_cast<size_t>(_width) * _height;
+
+    _kinds.assign(totalCells, BASIC);
+    _values.assign(totalCells, 0);
+    _targets.assign(totalCells, -1);
+    _available.assign(totalCells, 0);
+
+    for (int y = 0; y < _height; y++) {
+        for (int x = 0; x < _width; x++) {
+            int index = indexOf(x, y);
+            const ICell& cell = grid[Position(x, y)];
+            _available[index] = cell.isAvailable() ? 1 : 0;
+
+            switch (cell.getType()) {
+                case CellType::TELEPORT: {
+                    Position tpPos = static_cast<const TeleportCell&>(cell).getTPPos();
+                    _kinds[index] = TELEPORT;
+                    _targets[index] = indexOf(tpPos.getX(), tpPos.getY());
+                    break;
+                }
+                case CellType::BOMB:
+                    _kinds[index] = BOMB;
+                    break;
+                case CellType::BASIC:
+                    _values[index] = static_cast<uint8_t>(static_cast<const BasicCell&>(cell).getValue());
+                    break;
+            }
+        }
+    }
+}
+
+int BoardAnalyzer::indexOf(int x, int y) const {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) {
+        return -1;
+    }
+    return y * _width + x;
+}
+
+int BoardAnalyzer::followTeleports(int index) {
+    _chain.clear();
+    while (index >= 0 && _kinds[index] == TELEPORT && _available[index]) {
+        if (std::find(_chain.begin(), _chain.end(), index) != _chain.end()) {
+            return -1;
+        }
+        _chain.push_back(index);
+        index = _targets[index];
+    }
+    return index;
+}
+
+int BoardAnalyzer::staticLanding(int from, Direction direction) {
+    int d = static_cast<int>(direction);
+    int x = from % _width;
+    int y = from / _width;
+
+    int target = indexOf(x + STEP_X[d], y + STEP_Y[d]);
+    if (target < 0 || !_available[target]) {
+        return -1;
+    }
+
+    if (_kinds[target] == BOMB) {
+        return target;
+    }
+    if (_kinds[target] == TELEPORT) {
+        int tpTarget = _targets[target];
+        return (tpTarget >= 0 && _available[tpTarget]) ? staticTeleportLanding(tpTarget) : -1;
+    }
+
+    for (int step = 1; step <= _values[target]; step++) {
+        int index = indexOf(x + STEP_X[d] * step, y + STEP_Y[d] * step);
+        if (index < 0 || !_available[index]) {
+            return -1;
+        }
+        if (_kinds[index] == BOMB) {
+            return index;
+        }
+        if (_kinds[index] == TELEPORT) {
+            return staticTeleportLanding(_targets[index]);
+        }
+    }
+    return indexOf(x + STEP_X[d] * _values[target], y + STEP_Y[d] * _values[target]);
+}
+
+int BoardAnalyzer::staticTeleportLanding(int tpTarget) {
+    if (tpTarget < 0) {
+        return -1;
+    }
+    int finalIndex = followTeleports(tpTarget);
+    return (finalIndex >= 0 && _available[finalIndex]) ? finalIndex : -1;
+}
+
+void BoardAnalyzer::computeReachability(int start, BoardReport& report) {
+    report.reachable.assign(_kinds.size(), 0);
+    report.reachable[start] = 1;
+
+    _queue.clear();
+    _queue.push_back(start);
+
+    long long edges = 0;
+    for (size_t head = 0; head < _queue.size(); head++) {
+        int current = _queue[head];
+        for (Direction direction : MOVE_DIRECTIONS) {
+            int landing = staticLanding(current, direction);
+            if (landing < 0) continue;
+
+            edges++;
+            if (!report.reachable[landing]) {
+                report.reachable[landing] = 1;
+                _queue.push_back(landing);
+            }
+        }
+    }
+
+    report.reachableCells = static_cast<int>(_queue.size()) - 1;
+    report.meanBranching = static_cast<double>(edges) / _queue.size();
+
+    for (size_t i = 0; i < _kinds.size(); i++) {
+        if (_available[i] && !report.reachable[i]) {
+            report.deadCells++;
+        }
+    }
+}
+
+void BoardAnalyzer::summarizeTeleports(int start, BoardReport& report) {
+    TeleportSummary& summary = report.teleports;
+
+    for (size_t i = 0; i < _kinds.size(); i++) {
+        if (_kinds[i] != TELEPORT || !_available[i]) continue;
+
+        summary.teleports++;
+        int target = _targets[i];
+        if (target == start) summary.targetingStart++;
+        if (target >= 0 && _kinds[target] == BOMB) summary.targetingBomb++;
+        if (target >= 0 && _kinds[target] == TELEPORT) summary.targetingTeleport++;
+
+        int finalIndex = followTeleports(static_cast<int>(i));
+        if (finalIndex >= 0 && _kinds[finalIndex] == BOMB) {
+            summary.chainsToBomb++;
+        }
+        if (finalIndex < 0 &&
+            std::find(_chain.begin(), _chain.end(), _targets[_chain.back()]) == _chain.begin()) {
+            summary.inCycles++;
+        }
+    }
+}
+
+void BoardAnalyzer::consume(int index) {
+    if (_available[index]) {
+        _available[index] = 0;
+        _undo.push_back(index);
+    }
+}
+
+void BoardAnalyzer::rollback() {
+    for (int index : _undo) {
+        _available[index] = 1;
+    }
+    _undo.clear();
+}
+
+BoardAnalyzer::Collision BoardAnalyzer::collide(int index, int& score, int& player) {
+    if (_kinds[index] == BASIC) {
+        if (!_available[index]) return BLOCKED;
+        score += _values[index];
+        consume(index);
+        return PASSED;
+    }
+
+    if (_kinds[index] == BOMB) {
+        if (!_available[index]) return BLOCKED;
+        score -= static_cast<int>(score * 0.2) + 9;
+        consume(index);
+        if (score <= 0) {
+            score = 0;
+            return BLOCKED;
+        }
+        return STOPPED;
+    }
+
+    if (!_available[index]) return BLOCKED;
+    consume(index);
+    return teleportTo(_targets[index], score, player);
+}
+
+BoardAnalyzer::Collision BoardAnalyzer::teleportTo(int tpTarget, int& score, int& player) {
+    if (tpTarget < 0) return BLOCKED;
+
+    int finalIndex = followTeleports(tpTarget);
+    if (finalIndex < 0) return BLOCKED;
+    if (collide(finalIndex, score, player) == BLOCKED) return BLOCKED;
+
+    for (int teleport : _chain) {
+        consume(teleport);
+    }
+    player = finalIndex;
+    return TELEPORTED;
+}
+
+bool BoardAnalyzer::simulateMove(Direction direction, int& score, int& player) {
+    int d = static_cast<int>(direction);
+    int x = player % _width;
+    int y = player / _width;
+
+    int target = indexOf(x + STEP_X[d], y + STEP_Y[d]);
+    if (target < 0 || !_available[target]) {
+        return false;
+    }
+
+    if (_kinds[target] == TELEPORT) {
+        int tpTarget = _targets[target];
+        if (tpTarget < 0 || !_available[tpTarget]) return false;
+        consume(target);
+        player = target;
+        return teleportTo(tpTarget, score, player) != BLOCKED;
+    }
+
+    if (_kinds[target] == BOMB) {
+        player = target;
+        return collide(target, score, player) != BLOCKED;
+    }
+
+    int value = _values[target];
+    for (int step = 1; step <= value; step++) {
+        int index = indexOf(x + STEP_X[d] * step, y + STEP_Y[d] * step);
+        if (index < 0 || !_available[index]) return false;
+
+        switch (collide(index, score, player)) {
+            case BLOCKED:
+                return false;
+            case PASSED:
+                player = index;
+                break;
+            case STOPPED:
+                player = index;
+                return true;
+            case TELEPORTED:
+                return true;
+        }
+    }
+    return true;
+}
+
+void BoardAnalyzer::greedyPlayout(int start, BoardReport& report) {
+    int score = 0;
+    int player = start;
+    int maxMoves = static_cast<int>(_kinds.size());
+
+    while (report.greedyMoves < maxMoves) {
+        int bestGain = std::numeric_limits<int>::min();
+        Direction bestDirection = Direction::NONE;
+
+        for (Direction direction : MOVE_DIRECTIONS) {
+            int trialScore = score;
+            int trialPlayer = player;
+            _undo.clear();
+            bool alive = simulateMove(direction, trialScore, trialPlayer);
+            rollback();
+
+            if (alive && trialScore - score > bestGain) {
+                bestGain = trialScore - score;
+                bestDirection = direction;
+            }
+        }
+
+        if (bestDirection == Direction::NONE) break;
+
+        _undo.clear();
+        simulateMove(bestDirection, score, player);
+        _undo.clear();
+        report.greedyMoves++;
+    }
+
+    report.greedyScore = score;
+}
@@ -0,0 +1,66 @@
+#include "model/CellArena.hpp"
+#include <algorithm>
+
+CellArena::CellArena(size_t blockSize): _current(0), _used(0), _blockSize(blockSize) {}
+
+void* CellArena::allocate(size_t size, size_t alignment) {
+    while (_current < _blocks.size()) {
+        Block& block = _blocks[_current];
+        size_t offset = (_used + alignment - 1) & ~(alignment - 1);
+        if (offset + size <= block.size) {
+            _used = offset + size;
+            return reinterpret_cast<unsigned char*>(block.data.get()) + offset;
+        }
+        _current++;
+        _used = 0;
+    }
+
+    addBlock(size + alignment);
+    return allocate(size, alignment);
+}
+
+void CellArena::addBlock(size_t size) {
+    size = std::max(size, _blockSize);
+    size_t words = (size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+
+    Block block;
+    block.data.reset(new std::max_align_t[words]);
+    block.size = words * sizeof(std::max_align_t);
+
+    _blocks.push_back(std::move(block));
+    _current = _blocks.size() - 1;
+    _used = 0;
+}
+
+void CellArena::reserve(size_t bytes) {
+    for (size_t i = _current; i < _blocks.size(); i++) {
+        size_t used = (i == _current) ? _used : 0;
+        if (_blocks[i].size - used >= bytes) {
+            if (i != _current) {
+                _current = i;
+                _used = 0;
+            }
+            return;
+        }
+    }
+    addBlock(bytes);
+}
+
+void CellArena::reset() {
+    _current = 0;
+    _used = 0;
+}
+
+void CellArena::release() {
+    _blocks.clear();
+    _current = 0;
+    _used = 0;
+}
+
+size_t CellArena::capacity() const {
+    size_t total = 0;
+    for (const Block& block : _blocks) {
+        total += block.size;
+    }
+    return total;
+}
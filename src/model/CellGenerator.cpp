@@ -2,11 +2,22 @@
 #include "model/cells/BasicCell.hpp"
 #include "model/cells/BombCell.hpp"
 #include "model/cells/TeleportCell.hpp"
-#include <cmath>
+#include "model/CounterRng.hpp"
+#include "model/GenerationKernel.hpp"
 #include <ctime>
 #include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>
 
-Color CellGenerator::getColor(int value) {
+const int CellGenerator::BAND_ROWS;
+const int CellGenerator::PARALLEL_MIN_CELLS;
+
+CellGenerator::CellGenerator(unsigned int threadCount): _threadCount(threadCount) {}
+
+Color CellGenerator::getColor(int value) const {
     Color color;
 
     switch(value) {
@@ -32,89 +43,145 @@ Color CellGenerator::getColor(int value) {
     return color;
 }
 
-std::vector<ICell*> CellGenerator::generateRandomGrid(int width, int height) {
-    srand(time(NULL));
-    
-    std::vector<ICell*> grid;
-    grid.reserve(width * height);
-    
+size_t CellGenerator::cellSlotSize() {
+    size_t size = std::max({sizeof(BasicCell), sizeof(BombCell), sizeof(TeleportCell)});
+    size_t alignment = cellSlotAlignment();
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+size_t CellGenerator::cellSlotAlignment() {
+    return std::max({alignof(BasicCell), alignof(BombCell), alignof(TeleportCell)});
+}
+
+void CellGenerator::generateRegion(const Region& region, const Region& targets, int width, int height,
+                                   unsigned int seed, CellQuota quota, unsigned char* slots, ICell** cells) const {
+    CounterRng rng(seed);
+    const size_t stride = cellSlotSize();
+
     float centerX = (width - 1) / 2.0f;
     float centerY = (height - 1) / 2.0f;
-    float maxDistance = sqrt(centerX * centerX + centerY * centerY);
+    float maxDistance2 = centerX * centerX + centerY * centerY;
 
-    int bombCellsCount = 0;
-    int teleportCellsCount = 0;
-    int totalCells = width * height;
-    
-    int maxBombCells = totalCells / 12;
-    int maxTeleportCells = totalCells / 12;
-    
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            float dx = x - centerX;
-            float dy = y - centerY;
-            float distance = sqrt(dx * dx + dy * dy);
-            
-            float normalizedDistance = distance / maxDistance;
-            float invertedDistance = 1.0f - normalizedDistance * normalizedDistance;
-            
-            int value;
-            if (invertedDistance > 0.8f) {
-                value = 4 + rand() % 2;
-            } else if (invertedDistance > 0.5f) {
-                value = 3 + rand() % 2;
-            } else if (invertedDistance > 0.2f) {
-                value = 2 + rand() % 2;
-            } else {
-                value = 1 + rand() % 2;
-            }
-            
-            bool createSpecialCell = false;
-            int cellType = 0; 
-            
-            if (bombCellsCount < maxBombCells && rand() % 12 == 0) {
-                createSpecialCell = true;
-                cellType = 1;
-                bombCellsCount++;
-            } 
-            else if (teleportCellsCount < maxTeleportCells && rand() % 15 == 0) {
-                createSpecialCell = true;
-                cellType = 2;
-                teleportCellsCount++;
+    // invertedDistance = 1 - d^2 / max^2 > 0.2 / 0.5 / 0.8 без sqrt и деления на клетку
+    GenerationRow row;
+    row.centerX = centerX;
+    row.bandLimits[0] = 0.8f * maxDistance2;
+    row.bandLimits[1] = 0.5f * maxDistance2;
+    row.bandLimits[2] = 0.2f * maxDistance2;
+    row.x0 = region.x0;
+    row.count = region.width;
+
+    std::vector<uint8_t> packed(region.width);
+    for (int y = region.y0; y < region.y0 + region.height; y++) {
+        float dy = y - centerY;
+        row.dy2 = dy * dy;
+        row.valueStream = rng.stream(y, ROLL_VALUE);
+        row.bombStream = rng.stream(y, ROLL_BOMB);
+        row.teleportStream = rng.stream(y, ROLL_TELEPORT);
+        GenerationKernel::fillRow(row, packed.data());
+
+        for (int i = 0; i < region.width; i++) {
+            int x = region.x0 + i;
+            uint8_t cell = packed[i];
+
+            if ((cell & GenerationKernel::BOMB_FLAG) && quota.bombsLeft > 0) {
+                quota.bombsLeft--;
+                *cells = new (slots) BombCell();
             }
-            
-            if (createSpecialCell) {
-                if (cellType == 1) {
-                    grid.push_back(new BombCell());
-                } 
-                else if (cellType == 2) {
-                    int targetX = rand() % width;
-                    int targetY = rand() % height;
-                    
-                    if (targetX == x && targetY == y) {
-                        targetX = (x + 1) % width;
-                    }
-                    
-                    grid.push_back(new TeleportCell(Position(targetX, targetY)));
+            else if ((cell & GenerationKernel::TELEPORT_FLAG) && quota.teleportsLeft > 0) {
+                quota.teleportsLeft--;
+                int targetX = targets.x0 + CounterRng::reduce(CounterRng::at(rng.stream(y, ROLL_TARGET_X), x), targets.width);
+                int targetY = targets.y0 + CounterRng::reduce(CounterRng::at(rng.stream(y, ROLL_TARGET_Y), x), targets.height);
+
+                if (targetX == x && targetY == y) {
+                    targetX = targets.x0 + (x - targets.x0 + 1) % targets.width;
                 }
-            } 
+
+                *cells = new (slots) TeleportCell(Position(targetX, targetY));
+            }
             else {
-                Color color = getColor(value);
-                grid.push_back(new BasicCell(value, color));
+                int value = cell & GenerationKernel::VALUE_MASK;
+                *cells = new (slots) BasicCell(value, getColor(value));
             }
+
+            cells++;
+            slots += stride;
+        }
+    }
+}
+
+std::vector<ICell*> CellGenerator::generateRandomGrid(int width, int height, CellArena& arena) {
+    return generateRandomGrid(width, height, static_cast<unsigned int>(time(NULL)), arena);
+}
+
+std::vector<ICell*> CellGenerator::generateRandomGrid(int width, int height, unsigned int seed, CellArena& arena) {
+    int totalCells = width * height;
+    std::vector<ICell*> grid(totalCells);
+    if (totalCells <= 0) {
+        return grid;
+    }
+
+    const size_t stride = cellSlotSize();
+    unsigned char* slots = static_cast<unsigned char*>(arena.allocate(totalCells * stride, cellSlotAlignment()));
+    const Region board = {0, 0, width, height};
+    const int bands = (height + BAND_ROWS - 1) / BAND_ROWS;
+
+    std::atomic<int> nextBand(0);
+    auto worker = [&]() {
+        int band;
+        while ((band = nextBand++) < bands) {
+            Region region = {0, band * BAND_ROWS, width, std::min(BAND_ROWS, height - band * BAND_ROWS)};
+            int bandCells = region.width * region.height;
+
+            CellQuota quota;
+            quota.bombsLeft = bandCells / 12;
+            quota.teleportsLeft = bandCells / 12;
+
+            size_t first = static_cast<size_t>(region.y0) * width;
+            generateRegion(region, board, width, height, seed, quota, slots + first * stride, grid.data() + first);
         }
+    };
+
+    unsigned int threadCount = 1;
+    if (totalCells >= PARALLEL_MIN_CELLS) {
+        threadCount = _threadCount ? _threadCount : std::max(1u, std::thread::hardware_concurrency());
+        threadCount = std::min<unsigned int>(threadCount, bands);
+    }
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; i++) {
+        threads.emplace_back(worker);
     }
-    
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
     return grid;
 }
 
-ICell* CellGenerator::createBasicCell(int value) {
+std::vector<ICell*> CellGenerator::generateTile(int tileX, int tileY, int tileSize, int width, int height,
+                                                unsigned int seed, CellArena& arena) const {
+    Region tile = {tileX * tileSize, tileY * tileSize,
+                   std::min(tileSize, width - tileX * tileSize), std::min(tileSize, height - tileY * tileSize)};
+    int totalCells = tile.width * tile.height;
+
+    CellQuota quota;
+    quota.bombsLeft = totalCells / 12;
+    quota.teleportsLeft = totalCells / 12;
+
+    std::vector<ICell*> cells(totalCells);
+    unsigned char* slots = static_cast<unsigned char*>(arena.allocate(totalCells * cellSlotSize(), cellSlotAlignment()));
+    generateRegion(tile, tile, width, height, seed, quota, slots, cells.data());
+    return cells;
+}
+
+ICell* CellGenerator::createBasicCell(int value, CellArena& arena) {
     Color color = getColor(value);
-    return new BasicCell(value, color);
+    return arena.create<BasicCell>(value, color);
 }
 
-ICell* CellGenerator::createRandomCell() {
+ICell* CellGenerator::createRandomCell(CellArena& arena) {
     int value = rand() % 5 + 1;
     Color color = getColor(value);
-    return new BasicCell(value, color);
+    return arena.create<BasicCell>(value, color);
 }
\ No newline at end of file
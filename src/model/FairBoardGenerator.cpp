@@ -0,0 +1,100 @@
+#include "model/FairBoardGenerator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+FairBoardGenerator::FairBoardGenerator(unsigned int threadCount, int maxCandidates, std::chrono::milliseconds timeBudget):
+    _threadCount(threadCount), _maxCandidates(maxCandidates), _timeBudget(timeBudget) {
+    if (_threadCount == 0) {
+        _threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+unsigned int FairBoardGenerator::candidateSeed(unsigned int seed, int candidate) {
+    uint64_t z = (static_cast<uint64_t>(seed) << 32) + static_cast<uint64_t>(candidate) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z = z ^ (z >> 31);
+    return static_cast<unsigned int>(z);
+}
+
+bool FairBoardGenerator::satisfies(const BoardReport& report, const BoardConstraints& constraints) {
+    // Стартовая клетка уже израсходована, но остается клеткой поля в игре
+    double cellsInPlay = static_cast<double>(report.availableCells) + 1;
+    double bombDensity = report.bombs / cellsInPlay;
+    double teleportDensity = report.teleports.teleports / cellsInPlay;
+
+    return report.greedyScore >= constraints.minGreedyScore &&
+           report.reachableCells >= constraints.minReachableCells &&
+           bombDensity >= constraints.minBombDensity &&
+           bombDensity <= constraints.maxBombDensity &&
+           teleportDensity >= constraints.minTeleportDensity &&
+           teleportDensity <= constraints.maxTeleportDensity &&
+           (constraints.allowTeleportToBomb || report.teleports.chainsToBomb == 0) &&
+           report.teleports.inCycles == 0;
+}
+
+FairBoardResult FairBoardGenerator::generate(int width, int height, unsigned int seed, const BoardConstraints& constraints) const {
+    const auto deadline = std::chrono::steady_clock::now() + _timeBudget;
+
+    std::atomic<int> nextCandidate(0);
+    std::atomic<int> firstPassed(_maxCandidates);
+    std::atomic<int> evaluated(0);
+
+    std::mutex resultMutex;
+    FairBoardResult passed;
+    FairBoardResult fallback;
+    bool hasFallback = false;
+    int fallbackCandidate = 0;
+
+    auto worker = [&]() {
+        BoardAnalyzer analyzer;
+        while (true) {
+            int candidate = nextCandidate++;
+            if (candidate >= firstPassed.load() || std::chrono::steady_clock::now() > deadline) {
+                break;
+            }
+
+            unsigned int candidateSeedValue = candidateSeed(seed, candidate);
+            Grid grid(width, height, candidateSeedValue);
+            BoardReport report = analyzer.analyze(grid);
+            evaluated++;
+
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (satisfies(report, constraints)) {
+                if (candidate < firstPassed.load()) {
+                    firstPassed = candidate;
+                    passed.seed = candidateSeedValue;
+                    passed.satisfied = true;
+                    passed.report = std::move(report);
+                }
+            } else if (!hasFallback || report.greedyScore > fallback.report.greedyScore ||
+                       (report.greedyScore == fallback.report.greedyScore && candidate < fallbackCandidate)) {
+                // Равный счет - меньший номер: порядок захвата блокировки потоками не влияет на результат
+                hasFallback = true;
+                fallbackCandidate = candidate;
+                fallback.seed = candidateSeedValue;
+                fallback.report = std::move(report);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < _threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    bool found = passed.satisfied;
+    FairBoardResult result = found ? std::move(passed) : std::move(fallback);
+    result.candidates = evaluated.load();
+    if (!found && !hasFallback) {
+        result.seed = candidateSeed(seed, 0);
+    }
+    return result;
+}
@@ -1,23 +1,65 @@
 #include "model/GameModel.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/Tracer.hpp"
 #include <iostream>
 #include <ctime>
 #include <cstdlib>
 #include <stdexcept>
+#include <algorithm>
 
 GameModel::GameModel(int width, int height): 
     _grid(width, height), 
     _player(Position(width / 2, height / 2)),
     _score(0),
     _gameOver(false),
-    _interactionHandler(*this) {
+    _interactionHandler(*this),
+    _blockAggregatesBuilt(false),
+    _viewExtent(Grid::TILE_SIZE, Grid::TILE_SIZE) {
+    _availableMoves.reserve(4);
     initializeGame();
 }
 
+GameModel::GameModel(int width, int height, unsigned int seed): 
+    _grid(width, height, seed), 
+    _player(Position(width / 2, height / 2)),
+    _score(0),
+    _gameOver(false),
+    _interactionHandler(*this),
+    _blockAggregatesBuilt(false),
+    _viewExtent(Grid::TILE_SIZE, Grid::TILE_SIZE) {
+    _availableMoves.reserve(4);
+    initializeGame();
+}
+
+GameModel::GameModel(int width, int height,
+                     const std::vector<int>& cellValues,
+                     const std::vector<int>& cellColors,
+                     const std::vector<int>& cellAvailable,
+                     const std::vector<int>& cellTypes,
+                     const std::vector<int>& teleportTargetsX,
+                     const std::vector<int>& teleportTargetsY,
+                     const Position& playerPos,
+                     int score):
+    _grid(width, height, cellValues, cellColors, cellAvailable, cellTypes, teleportTargetsX, teleportTargetsY),
+    _player(playerPos),
+    _score(score),
+    _gameOver(false),
+    _interactionHandler(*this),
+    _blockAggregatesBuilt(false),
+    _viewExtent(Grid::TILE_SIZE, Grid::TILE_SIZE) {
+    _availableMoves.reserve(4);
+    initializeGame();
+}
 
 void GameModel::initializeGame() {
+    GREED_ALLOCATION_PHASE(GENERATION);
     if (_grid.isValidPosition(_player.getPosition())) {
         _grid.removeCell(_player.getPosition());
     }
+    if (!_blockAggregatesBuilt) {
+        _blockAggregates.build(_grid);
+        _blockAggregatesBuilt = true;
+    }
 }
 
 void GameModel::initializeGameFromState(
@@ -40,6 +82,8 @@ void GameModel::initializeGameFromState(
     if (_grid.isValidPosition(playerPos)) {
         _grid.removeCell(playerPos);
     }
+    _blockAggregates.build(_grid);
+    _blockAggregatesBuilt = true;
 }
 
 bool GameModel::isValidMove(Position position) const {
@@ -51,6 +95,8 @@ bool GameModel::isValidMove(Position position) const {
 }
 
 void GameModel::makeMove(Direction direction) {
+    GREED_TRACE_SCOPE("model", "makeMove");
+    GREED_ALLOCATION_PHASE(MOVE);
     if (_gameOver) return;
     
     Position playerPos = _player.getPosition();
@@ -78,7 +124,13 @@ void GameModel::makeMove(Direction direction) {
         return;
     }
 
-    _grid[targetCellPos].acceptInteractionStepOn(_interactionHandler, targetCellPos);
+    _interactionHandler.stepOn(targetCellPos);
+
+    if (_grid.needsCompaction()) {
+        Position player = _player.getPosition();
+        _grid.compactTiles(Position(player.getX() - _viewExtent.getX(), player.getY() - _viewExtent.getY()),
+                           player + _viewExtent);
+    }
 }
 
 bool GameModel::isGameOver() const {
@@ -106,10 +158,11 @@ const std::vector<Position>& GameModel::getAffectedElements() const {
 }
 
 std::vector<std::pair<bool, Position>>& GameModel::getAvailableMoves() {
+    GREED_ALLOCATION_PHASE(MOVE);
     _availableMoves.clear();
     
     Position playerPos = _player.getPosition();
-    std::vector<Position> directions = {
+    static const Position directions[] = {
         Position(0, -1),  
         Position(0, 1),   
         Position(-1, 0),  
@@ -123,3 +176,11 @@ std::vector<std::pair<bool, Position>>& GameModel::getAvailableMoves() {
     
     return _availableMoves;
 }
+
+BlockAggregates& GameModel::getBlockAggregates() {
+    return _blockAggregates;
+}
+
+void GameModel::setViewExtent(int columns, int rows) {
+    _viewExtent = Position(std::max(columns, Grid::TILE_SIZE), std::max(rows, Grid::TILE_SIZE));
+}
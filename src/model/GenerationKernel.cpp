@@ -0,0 +1,203 @@
+#include "model/GenerationKernel.hpp"
+#include "model/CounterRng.hpp"
+
+#if defined(__x86_64__)
+#define GREED_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// roll(12) == 0 и roll(15) == 0 при приведении CounterRng::reduce
+const uint32_t BOMB_LIMIT = 0xFFFFFFFFu / 12 + 1;
+const uint32_t TELEPORT_LIMIT = 0xFFFFFFFFu / 15 + 1;
+
+uint8_t encodeCell(const GenerationRow& row, int x) {
+    float dx = static_cast<float>(x) - row.centerX;
+    float d2 = dx * dx + row.dy2;
+
+    int value = 1 + (d2 < row.bandLimits[0]) + (d2 < row.bandLimits[1]) + (d2 < row.bandLimits[2]);
+    value += static_cast<int>(CounterRng::at(row.valueStream, x) >> 31);
+
+    uint8_t cell = static_cast<uint8_t>(value);
+    if (CounterRng::at(row.bombStream, x) < BOMB_LIMIT) cell |= GenerationKernel::BOMB_FLAG;
+    if (CounterRng::at(row.teleportStream, x) < TELEPORT_LIMIT) cell |= GenerationKernel::TELEPORT_FLAG;
+    return cell;
+}
+
+void fillScalar(const GenerationRow& row, int from, uint8_t* out) {
+    for (int i = from; i < row.count; i++) {
+        out[i] = encodeCell(row, row.x0 + i);
+    }
+}
+
+#ifdef GREED_KERNEL_X86
+
+inline __m128i mullo32(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+inline __m128i hashSse2(__m128i stream, __m128i xMul) {
+    __m128i v = _mm_xor_si128(stream, xMul);
+    v = _mm_xor_si128(v, _mm_srli_epi32(v, 16));
+    v = mullo32(v, _mm_set1_epi32(0x7FEB352D));
+    v = _mm_xor_si128(v, _mm_srli_epi32(v, 15));
+    v = mullo32(v, _mm_set1_epi32(static_cast<int>(0x846CA68Bu)));
+    v = _mm_xor_si128(v, _mm_srli_epi32(v, 16));
+    return v;
+}
+
+inline __m128i lessUnsignedSse2(__m128i a, uint32_t limit) {
+    const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    return _mm_cmplt_epi32(_mm_xor_si128(a, bias), _mm_set1_epi32(static_cast<int>(limit ^ 0x80000000u)));
+}
+
+void fillSse2(const GenerationRow& row, uint8_t* out) {
+    const __m128i valueStream = _mm_set1_epi32(static_cast<int>(row.valueStream));
+    const __m128i bombStream = _mm_set1_epi32(static_cast<int>(row.bombStream));
+    const __m128i teleportStream = _mm_set1_epi32(static_cast<int>(row.teleportStream));
+    const __m128 centerX = _mm_set1_ps(row.centerX);
+    const __m128 dy2 = _mm_set1_ps(row.dy2);
+    const __m128 limit0 = _mm_set1_ps(row.bandLimits[0]);
+    const __m128 limit1 = _mm_set1_ps(row.bandLimits[1]);
+    const __m128 limit2 = _mm_set1_ps(row.bandLimits[2]);
+    const __m128i xMulConst = _mm_set1_epi32(static_cast<int>(0xC2B2AE35u));
+    const __m128i one = _mm_set1_epi32(1);
+
+    int i = 0;
+    for (; i + 4 <= row.count; i += 4) {
+        __m128i x = _mm_add_epi32(_mm_set1_epi32(row.x0 + i), _mm_set_epi32(3, 2, 1, 0));
+        __m128 dx = _mm_sub_ps(_mm_cvtepi32_ps(x), centerX);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), dy2);
+
+        // Сравнения дают -1 в истинных полосах, поэтому вычитаются
+        __m128i value = one;
+        value = _mm_sub_epi32(value, _mm_castps_si128(_mm_cmplt_ps(d2, limit0)));
+        value = _mm_sub_epi32(value, _mm_castps_si128(_mm_cmplt_ps(d2, limit1)));
+        value = _mm_sub_epi32(value, _mm_castps_si128(_mm_cmplt_ps(d2, limit2)));
+
+        __m128i xMul = mullo32(x, xMulConst);
+        value = _mm_add_epi32(value, _mm_srli_epi32(hashSse2(valueStream, xMul), 31));
+
+        __m128i bomb = lessUnsignedSse2(hashSse2(bombStream, xMul), BOMB_LIMIT);
+        __m128i teleport = lessUnsignedSse2(hashSse2(teleportStream, xMul), TELEPORT_LIMIT);
+        value = _mm_or_si128(value, _mm_and_si128(bomb, _mm_set1_epi32(GenerationKernel::BOMB_FLAG)));
+        value = _mm_or_si128(value, _mm_and_si128(teleport, _mm_set1_epi32(GenerationKernel::TELEPORT_FLAG)));
+
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(value, value), _mm_setzero_si128());
+        uint32_t bytes = static_cast<uint32_t>(_mm_cvtsi128_si32(packed));
+        out[i] = static_cast<uint8_t>(bytes);
+        out[i + 1] = static_cast<uint8_t>(bytes >> 8);
+        out[i + 2] = static_cast<uint8_t>(bytes >> 16);
+        out[i + 3] = static_cast<uint8_t>(bytes >> 24);
+    }
+    fillScalar(row, i, out);
+}
+
+__attribute__((target("avx2")))
+inline __m256i hashAvx2(__m256i stream, __m256i xMul) {
+    __m256i v = _mm256_xor_si256(stream, xMul);
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(v, 16));
+    v = _mm256_mullo_epi32(v, _mm256_set1_epi32(0x7FEB352D));
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(v, 15));
+    v = _mm256_mullo_epi32(v, _mm256_set1_epi32(static_cast<int>(0x846CA68Bu)));
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(v, 16));
+    return v;
+}
+
+__attribute__((target("avx2")))
+inline __m256i lessUnsignedAvx2(__m256i a, uint32_t limit) {
+    const __m256i bias = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(limit ^ 0x80000000u)), _mm256_xor_si256(a, bias));
+}
+
+__attribute__((target("avx2")))
+void fillAvx2(const GenerationRow& row, uint8_t* out) {
+    const __m256i valueStream = _mm256_set1_epi32(static_cast<int>(row.valueStream));
+    const __m256i bombStream = _mm256_set1_epi32(static_cast<int>(row.bombStream));
+    const __m256i teleportStream = _mm256_set1_epi32(static_cast<int>(row.teleportStream));
+    const __m256 centerX = _mm256_set1_ps(row.centerX);
+    const __m256 dy2 = _mm256_set1_ps(row.dy2);
+    const __m256 limit0 = _mm256_set1_ps(row.bandLimits[0]);
+    const __m256 limit1 = _mm256_set1_ps(row.bandLimits[1]);
+    const __m256 limit2 = _mm256_set1_ps(row.bandLimits[2]);
+    const __m256i xMulConst = _mm256_set1_epi32(static_cast<int>(0xC2B2AE35u));
+    const __m256i lanes = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i one = _mm256_set1_epi32(1);
+
+    int i = 0;
+    for (; i + 8 <= row.count; i += 8) {
+        __m256i x = _mm256_add_epi32(_mm256_set1_epi32(row.x0 + i), lanes);
+        __m256 dx = _mm256_sub_ps(_mm256_cvtepi32_ps(x), centerX);
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), dy2);
+
+        __m256i value = one;
+        value = _mm256_sub_epi32(value, _mm256_castps_si256(_mm256_cmp_ps(d2, limit0, _CMP_LT_OQ)));
+        value = _mm256_sub_epi32(value, _mm256_castps_si256(_mm256_cmp_ps(d2, limit1, _CMP_LT_OQ)));
+        value = _mm256_sub_epi32(value, _mm256_castps_si256(_mm256_cmp_ps(d2, limit2, _CMP_LT_OQ)));
+
+        __m256i xMul = _mm256_mullo_epi32(x, xMulConst);
+        value = _mm256_add_epi32(value, _mm256_srli_epi32(hashAvx2(valueStream, xMul), 31));
+
+        __m256i bomb = lessUnsignedAvx2(hashAvx2(bombStream, xMul), BOMB_LIMIT);
+        __m256i teleport = lessUnsignedAvx2(hashAvx2(teleportStream, xMul), TELEPORT_LIMIT);
+        value = _mm256_or_si256(value, _mm256_and_si256(bomb, _mm256_set1_epi32(GenerationKernel::BOMB_FLAG)));
+        value = _mm256_or_si256(value, _mm256_and_si256(teleport, _mm256_set1_epi32(GenerationKernel::TELEPORT_FLAG)));
+
+        __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(words, words));
+    }
+    fillScalar(row, i, out);
+}
+
+#endif
+
+}
+
+GenerationKernel::Isa GenerationKernel::detectIsa() {
+#ifdef GREED_KERNEL_X86
+    static const Isa detected = __builtin_cpu_supports("avx2") ? AVX2 : SSE2;
+    return detected;
+#else
+    return SCALAR;
+#endif
+}
+
+const char* GenerationKernel::isaName(Isa isa) {
+    switch (isa) {
+        case AVX2:
+            return "avx2";
+        case SSE2:
+            return "sse2";
+        case SCALAR:
+        default:
+            return "scalar";
+    }
+}
+
+void GenerationKernel::fillRow(const GenerationRow& row, uint8_t* out) {
+    fillRow(row, out, detectIsa());
+}
+
+void GenerationKernel::fillRow(const GenerationRow& row, uint8_t* out, Isa isa) {
+    if (isa > detectIsa()) {
+        isa = detectIsa();
+    }
+
+    switch (isa) {
+#ifdef GREED_KERNEL_X86
+        case AVX2:
+            fillAvx2(row, out);
+            break;
+        case SSE2:
+            fillSse2(row, out);
+            break;
+#endif
+        default:
+            fillScalar(row, 0, out);
+            break;
+    }
+}
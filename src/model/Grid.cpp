@@ -2,29 +2,82 @@
 #include "model/cells/BasicCell.hpp"
 #include "model/cells/TeleportCell.hpp"
 #include "model/cells/BombCell.hpp"
+#include "core/AllocationTracker.hpp"
 #include <iostream>
 #include <ctime>
 #include <cstdlib>
 #include <stdexcept>
+#include <algorithm>
 
-Grid::Grid(int width, int height): _width(width), _height(height) {
+Grid::Grid(int width, int height):
+    _width(width), _height(height), _chunked(false), _seed(0), _consumedCell(0, Color::DEFAULT), _compactRetryAt(0) {
+    _consumedCell.setAvailable(false);
     initializeRandom();
 }
 
+Grid::Grid(int width, int height, unsigned int seed):
+    _width(width), _height(height), _chunked(false), _seed(0), _consumedCell(0, Color::DEFAULT), _compactRetryAt(0) {
+    _consumedCell.setAvailable(false);
+    initializeRandom(seed);
+}
+
+Grid::Grid(int width, int height,
+           const std::vector<int>& cellValues,
+           const std::vector<int>& cellColors,
+           const std::vector<int>& cellAvailable,
+           const std::vector<int>& cellTypes,
+           const std::vector<int>& teleportTargetsX,
+           const std::vector<int>& teleportTargetsY):
+    _width(width), _height(height), _chunked(false), _seed(0), _consumedCell(0, Color::DEFAULT), _compactRetryAt(0) {
+    _consumedCell.setAvailable(false);
+    restoreState(cellValues, cellColors, cellAvailable, cellTypes, teleportTargetsX, teleportTargetsY);
+}
+
 Grid::~Grid() {
     clearCells();
 }
 
+const int Grid::TILE_SIZE;
+const long long Grid::CHUNKED_THRESHOLD;
+const size_t Grid::MAX_RESIDENT_TILES;
+const size_t Grid::COMPACT_TARGET_TILES;
+
 void Grid::clearCells() {
     for (ICell* cell: _cells) 
-        delete cell;
+        cell->~ICell();
+    for (auto& entry : _tiles) {
+        for (ICell* cell : entry.second->cells)
+            cell->~ICell();
+    }
 
     _cells.clear();
+    _arena.reset();
+    _tiles.clear();
+    _consumedTiles.clear();
+    _compactRetryAt = 0;
+    _teleports.reset(_width, _height);
+}
+
+void Grid::reserveCells() {
+    const size_t maxCellSize = std::max({sizeof(BasicCell), sizeof(BombCell), sizeof(TeleportCell)});
+    _arena.reserve(static_cast<size_t>(_width) * _height * maxCellSize);
 }
 
 void Grid::initializeRandom() {
+    initializeRandom(static_cast<unsigned int>(time(NULL)));
+}
+
+void Grid::initializeRandom(unsigned int seed) {
+    GREED_ALLOCATION_PHASE(GENERATION);
     clearCells();
-    _cells = _generator.generateRandomGrid(_width, _height);
+    _seed = seed;
+    _chunked = static_cast<long long>(_width) * _height > CHUNKED_THRESHOLD;
+    if (_chunked) {
+        return;
+    }
+
+    _cells = _generator.generateRandomGrid(_width, _height, seed, _arena);
+    _teleports.build(_cells, _width, _height);
 }
 
 void Grid::restoreState(const std::vector<int>& cellValues, 
@@ -34,6 +87,7 @@ void Grid::restoreState(const std::vector<int>& cellValues,
                        const std::vector<int>& teleportTargetsX,
                        const std::vector<int>& teleportTargetsY) {
     clearCells();
+    _chunked = false;
     
     int totalCells = _width * _height;
     if (cellValues.size() != static_cast<size_t>(totalCells) ||
@@ -44,45 +98,181 @@ void Grid::restoreState(const std::vector<int>& cellValues,
         teleportTargetsY.size() != static_cast<size_t>(totalCells)) {
         throw std::runtime_error("Invalid grid state data");
     }
+
+    reserveCells();
+    _cells.reserve(totalCells);
     
     for (int i = 0; i < totalCells; i++) {
         int type = cellTypes[i];
         bool available = cellAvailable[i] != 0;
         
-        if (type == 1) { // TeleportCell
+        if (type == static_cast<int>(CellType::TELEPORT)) {
             int targetX = teleportTargetsX[i];
             int targetY = teleportTargetsY[i];
-            TeleportCell* teleportCell = new TeleportCell(Position(targetX, targetY));
+            TeleportCell* teleportCell = _arena.create<TeleportCell>(Position(targetX, targetY));
             teleportCell->setAvailable(available);
             _cells.push_back(teleportCell);
         }
-        else if (type == 2) { // BombCell
-            BombCell* bombCell = new BombCell();
+        else if (type == static_cast<int>(CellType::BOMB)) {
+            BombCell* bombCell = _arena.create<BombCell>();
             bombCell->setAvailable(available);
             _cells.push_back(bombCell);
         }
         else { // BasicCell
             int value = cellValues[i];
             Color color = static_cast<Color>(cellColors[i]);
-            BasicCell* cell = new BasicCell(value, color);
+            BasicCell* cell = _arena.create<BasicCell>(value, color);
             cell->setAvailable(available);
             _cells.push_back(cell);
         }
     }
+
+    _teleports.build(_cells, _width, _height);
 }
 
 ICell& Grid::operator[] (const Position& position) {
     if (!isValidPosition(position)) {
         throw std::out_of_range("Position out of range | Grid::operator[]");
     }
-    return *_cells[position.getY() * _width + position.getX()];
+    return cellAt(position);
 }
 
 const ICell& Grid::operator[] (const Position& position) const {
     if (!isValidPosition(position)) {
         throw std::out_of_range("Position out of range | Grid::operator[]");
     }
-    return *_cells[position.getY() * _width + position.getX()];
+    return cellAt(position);
+}
+
+ICell& Grid::cellAt(const Position& position) const {
+    if (!_chunked) {
+        return *_cells[position.getY() * _width + position.getX()];
+    }
+
+    int tileX = position.getX() / TILE_SIZE;
+    int tileY = position.getY() / TILE_SIZE;
+    if (!_consumedTiles.empty() &&
+        _consumedTiles.count(static_cast<long long>(tileY) * tilesX() + tileX)) {
+        return _consumedCell;
+    }
+
+    Tile& tile = touchTile(tileX, tileY);
+    int localX = position.getX() - tileX * TILE_SIZE;
+    int localY = position.getY() - tileY * TILE_SIZE;
+    return *tile.cells[localY * tile.width + localX];
+}
+
+Grid::Tile& Grid::touchTile(int tileX, int tileY) const {
+    long long key = static_cast<long long>(tileY) * tilesX() + tileX;
+    auto it = _tiles.find(key);
+    if (it != _tiles.end()) {
+        return *it->second;
+    }
+
+    GREED_ALLOCATION_PHASE(GENERATION);
+    std::unique_ptr<Tile> tile(new Tile());
+    tile->width = std::min(TILE_SIZE, _width - tileX * TILE_SIZE);
+    tile->cells = _generator.generateTile(tileX, tileY, TILE_SIZE, _width, _height, _seed, tile->arena);
+
+    for (size_t i = 0; i < tile->cells.size(); i++) {
+        const ICell* cell = tile->cells[i];
+        if (cell->getType() != CellType::TELEPORT) continue;
+        Position cellPos(tileX * TILE_SIZE + static_cast<int>(i) % tile->width,
+                         tileY * TILE_SIZE + static_cast<int>(i) / tile->width);
+        _teleports.add(cellPos, static_cast<const TeleportCell*>(cell)->getTPPos(), cell->isAvailable());
+    }
+    _teleports.resolvePending();
+
+    Tile& result = *tile;
+    _tiles.emplace(key, std::move(tile));
+    return result;
+}
+
+void Grid::dropTile(long long key, bool consumed) {
+    auto it = _tiles.find(key);
+    if (it == _tiles.end()) return;
+
+    Tile& tile = *it->second;
+    int tileX = static_cast<int>(key % tilesX());
+    int tileY = static_cast<int>(key / tilesX());
+    for (size_t i = 0; i < tile.cells.size(); i++) {
+        if (tile.cells[i]->getType() == CellType::TELEPORT) {
+            _teleports.erase(Position(tileX * TILE_SIZE + static_cast<int>(i) % tile.width,
+                                      tileY * TILE_SIZE + static_cast<int>(i) / tile.width));
+        }
+        tile.cells[i]->~ICell();
+    }
+
+    _tiles.erase(it);
+    if (consumed) {
+        _consumedTiles.insert(key);
+    }
+}
+
+bool Grid::needsCompaction() const {
+    return _chunked && _tiles.size() > std::max(MAX_RESIDENT_TILES, _compactRetryAt);
+}
+
+void Grid::compactTiles(const Position& keepFrom, const Position& keepTo) {
+    GREED_ALLOCATION_PHASE(GENERATION);
+    int keepX0 = keepFrom.getX() / TILE_SIZE;
+    int keepY0 = keepFrom.getY() / TILE_SIZE;
+    int keepX1 = keepTo.getX() / TILE_SIZE;
+    int keepY1 = keepTo.getY() / TILE_SIZE;
+
+    std::vector<long long> consumed;
+    std::vector<std::pair<int, long long>> pristine;
+    for (const auto& entry : _tiles) {
+        int tileX = static_cast<int>(entry.first % tilesX());
+        int tileY = static_cast<int>(entry.first / tilesX());
+        if (tileX >= keepX0 && tileX <= keepX1 && tileY >= keepY0 && tileY <= keepY1) {
+            continue;
+        }
+
+        bool isPristine = true;
+        bool isConsumed = true;
+        for (const ICell* cell : entry.second->cells) {
+            if (cell->isAvailable()) isConsumed = false;
+            else isPristine = false;
+            if (!isPristine && !isConsumed) break;
+        }
+        if (isConsumed) {
+            consumed.push_back(entry.first);
+        } else if (isPristine) {
+            // Расстояние в тайлах до защищенной области: дальние выгружаются первыми
+            int distance = std::max({keepX0 - tileX, tileX - keepX1, keepY0 - tileY, tileY - keepY1});
+            pristine.emplace_back(distance, entry.first);
+        }
+    }
+
+    for (long long key : consumed) {
+        dropTile(key, true);
+    }
+
+    std::sort(pristine.begin(), pristine.end(),
+              [](const std::pair<int, long long>& a, const std::pair<int, long long>& b) {
+                  return a.first > b.first;
+              });
+    for (const auto& entry : pristine) {
+        if (_tiles.size() <= COMPACT_TARGET_TILES) break;
+        dropTile(entry.second, false);
+    }
+
+    // Остальные тайлы частично израсходованы или видны: повторять проход
+    // на каждом ходу бесполезно, пока игрок не загрузит новые тайлы
+    _compactRetryAt = _tiles.size() > MAX_RESIDENT_TILES ? _tiles.size() : 0;
+}
+
+bool Grid::isChunked() const {
+    return _chunked;
+}
+
+size_t Grid::getResidentTiles() const {
+    return _tiles.size();
+}
+
+int Grid::tilesX() const {
+    return (_width + TILE_SIZE - 1) / TILE_SIZE;
 }
 
 bool Grid::isValidPosition(const Position& position) const {
@@ -97,7 +287,12 @@ void Grid::removeCell(const Position& position) {
     if (!isValidPosition(position)) {
         throw std::out_of_range("Position out of range | Grid::removeCell()");
     }
-    (*this)[position].setAvailable(false);
+    cellAt(position).setAvailable(false);
+    _teleports.markConsumed(position);
+}
+
+const TeleportTable& Grid::getTeleports() const {
+    return _teleports;
 }
 
 int Grid::getWidth() const {
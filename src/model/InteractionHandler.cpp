@@ -1,26 +1,33 @@
 #include "model/InteractionHandler.hpp"
 #include "model/GameModel.hpp"
+#include "core/Tracer.hpp"
 #include <cstdlib>
 
-#define FALSE 0
-#define TRUE 1
-#define BOMB 2
-#define TP 3
+namespace {
+// Результаты столкновения (константы, а не макросы: BOMB совпадает с CellType::BOMB)
+enum CollisionResult { FALSE = 0, TRUE = 1, BOMB = 2, TP = 3 };
+}
 
 
-InteractionHandler::InteractionHandler(GameModel& model): _model(model), _lastFinalPos(0, 0) {};
+InteractionHandler::InteractionHandler(GameModel& model): _model(model), _lastFinalPos(0, 0) {
+    // Прыжок не длиннее 10 клеток; запас под цепочки телепортов, чтобы буферы не росли во время ходов
+    _prevMoveAffectedElements.reserve(64);
+    _jumpPath.reserve(64);
+}
 
-int InteractionHandler::collideWithBasicCell(BasicCell& cell) {
+int InteractionHandler::collideWithBasicCell(BasicCell& cell, const Position& cellPos) {
     if (!cell.isAvailable()) 
         return FALSE;
 
     _model._score += cell.getValue();
     cell.setAvailable(false);
+    _model._blockAggregates.consume(cellPos, CellType::BASIC, cell.getValue());
 
     return TRUE;
 }
 
 Position InteractionHandler::stepOnBasicCell(BasicCell& cell, const Position& cellPos) {
+    GREED_TRACE_SCOPE("model", "stepOnBasicCell");
     Position playerPos = _model._player.getPosition();
     int moveValue = cell.getValue();
     int dx = cellPos.getX() - playerPos.getX();
@@ -35,20 +42,21 @@ Position InteractionHandler::stepOnBasicCell(BasicCell& cell, const Position& ce
 }
 
 void InteractionHandler::handleStepOnBasicCell(const Position& startPos, const Position& finalPos) {
+    GREED_TRACE_SCOPE("model", "handleStepOnBasicCell");
     _prevMoveAffectedElements.clear();
     _prevMoveAffectedElements.emplace_back(_model._player.getPosition());
 
-    std::vector<Position> jumpedOver = makeOver(_model._player.getPosition(), finalPos);
+    makeOver(_model._player.getPosition(), finalPos, _jumpPath);
     
-    for (size_t i = 1; i < jumpedOver.size(); i++) {
-        Position cellPos = jumpedOver[i];
+    for (size_t i = 1; i < _jumpPath.size(); i++) {
+        Position cellPos = _jumpPath[i];
         
         if (!_model.isValidMove(cellPos)) {
             _model._gameOver = true;
             return;
         }
 
-        int canContinue = _model._grid[cellPos].acceptInteractionColission(*this);
+        int canContinue = collideAt(cellPos);
 
         switch (canContinue) {
             case FALSE:
@@ -72,20 +80,43 @@ void InteractionHandler::handleStepOnBasicCell(const Position& startPos, const P
     }
 }
 
-int InteractionHandler::collideWithTeleportCell(TeleportCell& cell) {
-    Position tpPos = cell.getTPPos();
-    int canContinue = _model._grid[tpPos].acceptInteractionColission(*this);
-    if (!canContinue) 
+int InteractionHandler::collideWithTeleportCell(TeleportCell& cell, const Position& cellPos) {
+    if (!cell.isAvailable())
         return FALSE;
-    
-    cell.setAvailable(false);
-    _model._player.setPosition(tpPos);
-    _prevMoveAffectedElements.emplace_back(tpPos);
+
+    _model._grid.removeCell(cellPos);
+    _model._blockAggregates.consume(cellPos, CellType::TELEPORT, 0);
+    return teleportTo(cell.getTPPos());
+}
+
+int InteractionHandler::teleportTo(const Position& tpPos) {
+    GREED_TRACE_SCOPE("model", "teleportTo");
+    Grid& grid = _model._grid;
+    TeleportResolution resolution = grid.getTeleports().resolve(tpPos);
+    if (resolution.cycle || !grid.isValidPosition(resolution.destination))
+        return FALSE;
+
+    int canContinue = collideAt(resolution.destination);
+    if (!canContinue)
+        return FALSE;
+
+    Position hop = tpPos;
+    while (grid.getTeleports().isActiveTeleport(hop)) {
+        Position next = grid.getTeleports().getTarget(hop);
+        grid.removeCell(hop);
+        _model._blockAggregates.consume(hop, CellType::TELEPORT, 0);
+        _prevMoveAffectedElements.emplace_back(hop);
+        hop = next;
+    }
+
+    _model._player.setPosition(resolution.destination);
+    _prevMoveAffectedElements.emplace_back(resolution.destination);
 
     return TP;
 }
 
 void InteractionHandler::stepOnTeleportCell(TeleportCell& cell, const Position& cellPos) {
+    GREED_TRACE_SCOPE("model", "stepOnTeleportCell");
     _prevMoveAffectedElements.clear();
     _prevMoveAffectedElements.emplace_back(_model._player.getPosition());
 
@@ -94,28 +125,26 @@ void InteractionHandler::stepOnTeleportCell(TeleportCell& cell, const Position&
         _model._gameOver = true;
         return;
     }
-    cell.setAvailable(false);   
+    _model._grid.removeCell(cellPos);
+    _model._blockAggregates.consume(cellPos, CellType::TELEPORT, 0);
 
     _prevMoveAffectedElements.emplace_back(cellPos);
     _model._player.setPosition(cellPos);
 
-    int canContinue = _model._grid[tpPos].acceptInteractionColission(*this);
+    int canContinue = teleportTo(tpPos);
     if (!canContinue) {
         _model._gameOver = true;
         return;
     }
-    
-    _model._player.setPosition(tpPos);
-    _prevMoveAffectedElements.emplace_back(tpPos);
-
 }
 
-int InteractionHandler::collideWithBombCell(BombCell& cell) {
+int InteractionHandler::collideWithBombCell(BombCell& cell, const Position& cellPos) {
     if (!cell.isAvailable())
         return FALSE;
 
     _model._score -= static_cast<int>(_model._score * 0.2) + 9;
     cell.setAvailable(false);
+    _model._blockAggregates.consume(cellPos, CellType::BOMB, 0);
 
     if (_model._score <= 0) {
         _model._score = 0;
@@ -126,6 +155,7 @@ int InteractionHandler::collideWithBombCell(BombCell& cell) {
 }
 
 void InteractionHandler::stepOnBombCell(BombCell& cell, const Position& cellPos) {
+    GREED_TRACE_SCOPE("model", "stepOnBombCell");
     _prevMoveAffectedElements.clear();
     _prevMoveAffectedElements.emplace_back(_model._player.getPosition());
 
@@ -137,16 +167,49 @@ void InteractionHandler::stepOnBombCell(BombCell& cell, const Position& cellPos)
     _model._player.setPosition(cellPos);
     _prevMoveAffectedElements.emplace_back(cellPos);
     
-    int canContinue = _model._grid[cellPos].acceptInteractionColission(*this);
+    int canContinue = collideAt(cellPos);
     if (!canContinue) {
         _model._gameOver = true;
         return;
     }
 }
 
+int InteractionHandler::collideAt(const Position& cellPos) {
+    GREED_TRACE_SCOPE("model", "collideAt");
+    ICell& cell = _model._grid[cellPos];
+    switch (cell.getType()) {
+        case CellType::TELEPORT:
+            return collideWithTeleportCell(static_cast<TeleportCell&>(cell), cellPos);
+        case CellType::BOMB:
+            return collideWithBombCell(static_cast<BombCell&>(cell), cellPos);
+        case CellType::BASIC:
+        default:
+            return collideWithBasicCell(static_cast<BasicCell&>(cell), cellPos);
+    }
+}
+
+void InteractionHandler::stepOn(const Position& cellPos) {
+    ICell& cell = _model._grid[cellPos];
+    switch (cell.getType()) {
+        case CellType::TELEPORT:
+            stepOnTeleportCell(static_cast<TeleportCell&>(cell), cellPos);
+            break;
+        case CellType::BOMB:
+            stepOnBombCell(static_cast<BombCell&>(cell), cellPos);
+            break;
+        case CellType::BASIC:
+        default: {
+            Position finalPos = stepOnBasicCell(static_cast<BasicCell&>(cell), cellPos);
+            handleStepOnBasicCell(cellPos, finalPos);
+            break;
+        }
+    }
+}
+
 
-std::vector<Position> InteractionHandler::makeOver(const Position& current, const Position& target) const {
-    std::vector<Position> jumpedOver;
+void InteractionHandler::makeOver(const Position& current, const Position& target, std::vector<Position>& jumpedOver) const {
+    GREED_TRACE_SCOPE("model", "makeOver");
+    jumpedOver.clear();
 
     int dx = target.getX() - current.getX();
     int dy = target.getY() - current.getY();
@@ -167,8 +230,6 @@ std::vector<Position> InteractionHandler::makeOver(const Position& current, cons
             current.getY() + i * stepY
         ));
     }
-    
-    return jumpedOver;
 }
 
 const std::vector<Position>& InteractionHandler::getAffectedElements() const{
@@ -0,0 +1,158 @@
+#include "model/TeleportTable.hpp"
+#include "model/cells/TeleportCell.hpp"
+#include <algorithm>
+
+TeleportTable::TeleportTable(): _width(0), _height(0) {
+    _walk.reserve(64);
+}
+
+long long TeleportTable::indexOf(const Position& position) const {
+    if (position.getX() < 0 || position.getY() < 0 ||
+        position.getX() >= _width || position.getY() >= _height) {
+        return -1;
+    }
+    return static_cast<long long>(position.getY()) * _width + position.getX();
+}
+
+const TeleportTable::Node* TeleportTable::find(const Position& position) const {
+    auto it = _nodes.find(indexOf(position));
+    return it != _nodes.end() ? &it->second : nullptr;
+}
+
+void TeleportTable::clear() {
+    _nodes.clear();
+    _pending.clear();
+}
+
+void TeleportTable::reset(int width, int height) {
+    clear();
+    _width = width;
+    _height = height;
+}
+
+void TeleportTable::build(const std::vector<ICell*>& cells, int width, int height) {
+    reset(width, height);
+
+    for (size_t i = 0; i < cells.size(); i++) {
+        if (!cells[i] || cells[i]->getType() != CellType::TELEPORT) continue;
+        const TeleportCell* teleportCell = static_cast<const TeleportCell*>(cells[i]);
+        add(Position(static_cast<int>(i % width), static_cast<int>(i / width)),
+            teleportCell->getTPPos(), teleportCell->isAvailable());
+    }
+
+    resolvePending();
+}
+
+void TeleportTable::add(const Position& position, const Position& target, bool available) {
+    long long index = indexOf(position);
+    if (index < 0) return;
+
+    Node& node = _nodes[index];
+    node.target = target;
+    node.destination = target;
+    node.cycle = false;
+    node.resolved = false;
+    node.available = available;
+    _pending.push_back(index);
+}
+
+void TeleportTable::erase(const Position& position) {
+    auto it = _nodes.find(indexOf(position));
+    if (it == _nodes.end()) return;
+
+    auto target = _nodes.find(indexOf(it->second.target));
+    if (target != _nodes.end() && target != it) {
+        std::vector<long long>& sources = target->second.sources;
+        sources.erase(std::remove(sources.begin(), sources.end(), it->first), sources.end());
+    }
+    _nodes.erase(it);
+}
+
+void TeleportTable::resolvePending() {
+    for (long long index : _pending) {
+        auto node = _nodes.find(index);
+        if (node == _nodes.end()) continue;
+        auto target = _nodes.find(indexOf(node->second.target));
+        if (target != _nodes.end()) {
+            target->second.sources.push_back(index);
+        }
+    }
+
+    std::vector<Node*> path;
+    for (long long index : _pending) {
+        auto entry = _nodes.find(index);
+        if (entry == _nodes.end() || !entry->second.available || entry->second.resolved) continue;
+
+        path.clear();
+        Node* current = &entry->second;
+        Position destination = current->target;
+        bool cycle = false;
+        while (true) {
+            current->resolved = true;
+            path.push_back(current);
+
+            auto next = _nodes.find(indexOf(current->target));
+            if (next == _nodes.end() || !next->second.available) {
+                destination = current->target;
+                break;
+            }
+            if (next->second.resolved) {
+                // Узел либо уже разрешен ранее, либо лежит на текущем пути (цикл)
+                bool onPath = false;
+                for (const Node* node : path) {
+                    if (node == &next->second) onPath = true;
+                }
+                cycle = onPath || next->second.cycle;
+                destination = next->second.destination;
+                break;
+            }
+            current = &next->second;
+        }
+
+        for (Node* node : path) {
+            node->destination = destination;
+            node->cycle = cycle;
+        }
+    }
+
+    _pending.clear();
+}
+
+bool TeleportTable::isActiveTeleport(const Position& position) const {
+    const Node* node = find(position);
+    return node && node->available;
+}
+
+Position TeleportTable::getTarget(const Position& position) const {
+    const Node* node = find(position);
+    return node ? node->target : position;
+}
+
+TeleportResolution TeleportTable::resolve(const Position& position) const {
+    const Node* node = find(position);
+    if (!node || !node->available) {
+        return TeleportResolution{position, false};
+    }
+    return TeleportResolution{node->destination, node->cycle};
+}
+
+void TeleportTable::markConsumed(const Position& position) {
+    auto it = _nodes.find(indexOf(position));
+    if (it == _nodes.end() || !it->second.available) return;
+
+    it->second.available = false;
+
+    _walk.assign(it->second.sources.begin(), it->second.sources.end());
+    while (!_walk.empty()) {
+        auto source = _nodes.find(_walk.back());
+        _walk.pop_back();
+        if (source == _nodes.end()) continue;
+
+        Node& node = source->second;
+        if (!node.available || (!node.cycle && node.destination == position)) continue;
+
+        node.destination = position;
+        node.cycle = false;
+        _walk.insert(_walk.end(), node.sources.begin(), node.sources.end());
+    }
+}
@@ -2,7 +2,7 @@
 #include "interfaces/ICellInteractionVisitor.hpp"
 #include "interfaces/ICellRenderVisitor.hpp"
 
-BasicCell::BasicCell(int value, Color color): _value(value), _color(color), _isAvailable(true) {};
+BasicCell::BasicCell(int value, Color color): ICell(CellType::BASIC), _value(value), _color(color), _isAvailable(true) {};
 
 int BasicCell::getValue() const {
     return _value;
@@ -24,8 +24,8 @@ void BasicCell::acceptRender(ICellRenderVisitor& visitor, const Position& pos, C
     visitor.drawBasicCell(*this, pos, highlightColor);
 }
 
-int BasicCell::acceptInteractionColission(ICellInteractionVisitor& visitor) {
-    return visitor.collideWithBasicCell(*this);
+int BasicCell::acceptInteractionColission(ICellInteractionVisitor& visitor, const Position& position) {
+    return visitor.collideWithBasicCell(*this, position);
 }
 
 void BasicCell::acceptInteractionStepOn(ICellInteractionVisitor& visitor, const Position& position) {
@@ -2,7 +2,7 @@
 #include "interfaces/ICellInteractionVisitor.hpp"
 #include "interfaces/ICellRenderVisitor.hpp"
 
-BombCell::BombCell(): _isAvailable(true) {};
+BombCell::BombCell(): ICell(CellType::BOMB), _isAvailable(true) {};
 
 bool BombCell::isAvailable() const {
     return _isAvailable;
@@ -16,8 +16,8 @@ void BombCell::acceptRender(ICellRenderVisitor& visitor, const Position& pos, Co
     visitor.drawBombCell(*this, pos);
 }
 
-int BombCell::acceptInteractionColission(ICellInteractionVisitor& visitor) {
-    return visitor.collideWithBombCell(*this);
+int BombCell::acceptInteractionColission(ICellInteractionVisitor& visitor, const Position& position) {
+    return visitor.collideWithBombCell(*this, position);
 }
 
 void BombCell::acceptInteractionStepOn(ICellInteractionVisitor& visitor, const Position& position) {
@@ -2,7 +2,7 @@
 #include "interfaces/ICellInteractionVisitor.hpp"
 #include "interfaces/ICellRenderVisitor.hpp"
 
-TeleportCell::TeleportCell(Position teleportPos): _teleportPos(teleportPos), _tpAvailable(true) {}; 
+TeleportCell::TeleportCell(Position teleportPos): ICell(CellType::TELEPORT), _teleportPos(teleportPos), _tpAvailable(true) {}; 
 
 void TeleportCell::setAvailable(bool available) {
     _tpAvailable = available;
@@ -20,8 +20,8 @@ void TeleportCell::acceptRender(ICellRenderVisitor& visitor, const Position& pos
     visitor.drawTeleportCell(*this, pos);
 }
 
-int TeleportCell::acceptInteractionColission(ICellInteractionVisitor& visitor) {
-    return visitor.collideWithTeleportCell(*this);
+int TeleportCell::acceptInteractionColission(ICellInteractionVisitor& visitor, const Position& position) {
+    return visitor.collideWithTeleportCell(*this, position);
 }
 
 void TeleportCell::acceptInteractionStepOn(ICellInteractionVisitor& visitor, const Position& position) {
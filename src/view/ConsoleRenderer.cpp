@@ -1,19 +1,44 @@
 #include "view/ConsoleRenderer.hpp"
+#include "view/TerminalGeometry.hpp"
 #include <iostream>
+#include <iomanip>
 #include <unistd.h>
 #include <set>
 #include <functional>
 #include <iostream>
-#include <sys/ioctl.h>
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
 
-ConsoleRenderer::ConsoleRenderer(Position offset): 
-    _offset(offset + Position(0, 1)),
+ConsoleRenderer::ConsoleRenderer(Position offset, Viewport* viewport): 
     _playerSymbol("X "),
     _emptycellSymbol(". "),
     _teleportCellSymbol("T "),
-    _bombCellSymbol("B ")
+    _bombCellSymbol("B "),
+    _offset(offset + Position(0, 1)),
+    _viewport(viewport),
+    _minimapPlayerBlock(-1, -1),
+    _sidePanel(false)
 {
     initializeColorCodes();
+    initializeGlyphs();
+}
+
+void ConsoleRenderer::initializeGlyphs() {
+    _bigDigitGlyphs = {
+        {" ##  ", "###  ", " ##  ", " ##  ", " ##  ", " ##  ", "#### "},
+        {" ####  ", "##  ## ", "   ##  ", "  ##   ", " ##    ", "##     ", "###### "},
+        {" ####  ", "##  ## ", "    ## ", "  ###  ", "    ## ", "##  ## ", " ####  "},
+        {"   ##   ", "  ###   ", " ## ##  ", "##  ##  ", "####### ", "   ##   ", "   ##   "},
+        {"###### ", "##     ", "##     ", "#####  ", "    ## ", "##  ## ", " ####  "}
+    };
+
+    _bigDigitWidth = 0;
+    for (const auto& digit : _bigDigitGlyphs) {
+        for (const auto& row : digit) {
+            _bigDigitWidth = std::max(_bigDigitWidth, static_cast<int>(row.length()));
+        }
+    }
 }
 
 void ConsoleRenderer::initializeColorCodes() {
@@ -50,21 +75,29 @@ void ConsoleRenderer::moveCursor(const Position& pos) const {
     std::cout << "\033[" << screenY << ";" << screenX << "H";
 }
 
+void ConsoleRenderer::relayout(Position offset) {
+    _offset = offset + Position(0, 1);
+    _minimapPlayerBlock = Position(-1, -1);
+}
+
+Position ConsoleRenderer::toScreen(const Position& cellPos) const {
+    Position local = _viewport->toLocal(cellPos);
+    return Position(_offset.getX() + local.getX() * 2, _offset.getY() + local.getY());
+}
+
 void ConsoleRenderer::showCursor() const {
     std::cout << "\033[?25h";
-    std::cout.flush();
 }
 
 void ConsoleRenderer::hideCursor() const {
     std::cout << "\033[?25l";
-    std::cout.flush();
 }
 
 void ConsoleRenderer::drawBasicCell(const BasicCell& cell, const Position& pos, Color highlightColor) const {
     moveCursor(pos);
 
     if (cell.isAvailable()) {
-        std::string colorCode = _colorCodes.at(cell.getColor());
+        const std::string& colorCode = _colorCodes.at(cell.getColor());
         
         if (highlightColor != Color::DEFAULT) {
             std::cout << _colorCodes.at(highlightColor) << "\033[1m" 
@@ -102,46 +135,20 @@ void ConsoleRenderer::drawBombCell(const BombCell& cell, const Position& pos) co
 void ConsoleRenderer::drawStartingState(const Grid& grid) {
     hideCursor();
 
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-    int terminalWidth = w.ws_col;
-    int terminalHeight = w.ws_row;
+    TerminalSize w = TerminalGeometry::get();
+    int terminalWidth = w.columns;
+    int terminalHeight = w.rows;
 
-    int gridWidth = grid.getWidth();
-    int gridHeight = grid.getHeight();
-    int visualWidth = gridWidth * 2;
-    
-    std::vector<std::vector<std::string>> bigNumbers = {
-        {" ##  ", "###  ", " ##  ", " ##  ", " ##  ", " ##  ", "#### "},
-        {" ####  ", "##  ## ", "   ##  ", "  ##   ", " ##    ", "##     ", "###### "},
-        {" ####  ", "##  ## ", "    ## ", "  ###  ", "    ## ", "##  ## ", " ####  "},
-        {"   ##   ", "  ###   ", " ## ##  ", "##  ##  ", "####### ", "   ##   ", "   ##   "},
-        {"###### ", "##     ", "##     ", "#####  ", "    ## ", "##  ## ", " ####  "}
-    };
-    std::string colors[5] = {"\033[1;31m", "\033[1;32m", "\033[1;34m", "\033[1;33m", "\033[1;35m"};
-     
-    int maxLeftNumberWidth = 0;
-    for (int i = 0; i < 5; i++) {
-        for (const auto& row : bigNumbers[i]) {
-            if (row.length() > maxLeftNumberWidth) {
-                maxLeftNumberWidth = row.length();
-            }
-        }
-    }
-    
-    int maxRightNumberWidth = 0;
-    for (int i = 0; i < 5; i++) {
-        for (const auto& row : bigNumbers[i]) {
-            if (row.length() > maxRightNumberWidth) {
-                maxRightNumberWidth = row.length();
-            }
-        }
-    }
+    int gridHeight = _viewport->getHeight();
+    int visualWidth = _viewport->getWidth() * 2;
     
-    int totalNeededWidth = visualWidth + maxLeftNumberWidth + maxRightNumberWidth + 4;
-    if (totalNeededWidth > terminalWidth) {
+    const std::vector<std::vector<std::string>>& bigNumbers = _bigDigitGlyphs;
+    const std::string* colors = _bigDigitColors;
+
+    int totalNeededWidth = visualWidth + _bigDigitWidth * 2 + 4;
+    if (totalNeededWidth > terminalWidth || !_viewport->coversBoard()) {
     } else {
-        for (int i = 0; i < 5; i++) {
+        for (int i = 0; i < 5 && !_sidePanel; i++) {
             int digitY = _offset.getY() + (i * (gridHeight / 5));
             
             for (int row = 0; row < 7; row++) {
@@ -179,24 +186,7 @@ void ConsoleRenderer::drawStartingState(const Grid& grid) {
     }
 
     for (int row = 0; row < gridHeight; row++) {
-        Position leftBorderPos(_offset.getX() - 1, _offset.getY() + row);
-        moveCursor(leftBorderPos);
-        std::cout << "\033[40m \033[0m";
-        
-        Position rightBorderPos(_offset.getX() + visualWidth, _offset.getY() + row);
-        moveCursor(rightBorderPos);
-        std::cout << "\033[40m \033[0m";
-        
-        for (int col = 0; col < gridWidth; col++) {
-            const Position& cellPos = Position(col, row);
-            const ICell& cell = grid[cellPos];
-            
-            Position drawPos = Position(_offset.getX() + col * 2, _offset.getY() + row);
-            
-            std::cout << "\033[47m";
-            cell.acceptRender(*this, drawPos);
-            std::cout <<_colorCodes.at(Color::DEFAULT);
-        }
+        drawWindowRow(grid, row);
     }
     
     for (int col = -1; col <= visualWidth; col++) {
@@ -206,41 +196,193 @@ void ConsoleRenderer::drawStartingState(const Grid& grid) {
     }
     
     int controlsY = _offset.getY() + gridHeight + 2;
-    std::string controls = "\033[32mW/↑ A/← S/↓ D/→\033[0m Move  \033[33mP\033[0m Pause  \033[34mF\033[0m Save  \033[35mM\033[0m Menu  \033[36mESC\033[0m Exit";
+    std::string controls = "\033[32mW/↑ A/← S/↓ D/→\033[0m Move  \033[33mP\033[0m Pause  \033[34mF\033[0m Save  \033[35mM\033[0m Menu  \033[90mL\033[0m Latency  \033[90mI\033[0m Stats  \033[36mESC\033[0m Exit";
     int controlsX = (terminalWidth - controls.length()) / 2;
     if (controlsX < 0) controlsX = 0;
     
     Position controlsPos(controlsX, controlsY);
     moveCursor(controlsPos);
     std::cout << controls;
+}
+
+void ConsoleRenderer::drawWindowRow(const Grid& grid, int row) {
+    int visualWidth = _viewport->getWidth() * 2;
+    Position origin = _viewport->getOrigin();
+
+    Position leftBorderPos(_offset.getX() - 1, _offset.getY() + row);
+    moveCursor(leftBorderPos);
+    std::cout << "\033[40m \033[0m";
     
-    std::cout.flush();
+    Position rightBorderPos(_offset.getX() + visualWidth, _offset.getY() + row);
+    moveCursor(rightBorderPos);
+    std::cout << "\033[40m \033[0m";
+    
+    for (int col = 0; col < _viewport->getWidth(); col++) {
+        const Position& cellPos = Position(origin.getX() + col, origin.getY() + row);
+        const ICell& cell = grid[cellPos];
+        
+        Position drawPos = Position(_offset.getX() + col * 2, _offset.getY() + row);
+        
+        std::cout << "\033[47m";
+        cell.acceptRender(*this, drawPos);
+        std::cout <<_colorCodes.at(Color::DEFAULT);
+    }
+}
+
+void ConsoleRenderer::scrollWindow(int rows) const {
+    int top = _offset.getY() + 1;
+    int bottom = _offset.getY() + _viewport->getHeight();
+
+    std::cout << "\033[" << top << ";" << bottom << "r";
+    if (rows > 0) {
+        std::cout << "\033[" << rows << "S";
+    } else {
+        std::cout << "\033[" << -rows << "T";
+    }
+    std::cout << "\033[r";
+}
+
+bool ConsoleRenderer::followPlayer(const Grid& grid, const Position& playerPos) {
+    Position shift = _viewport->follow(playerPos);
+    int height = _viewport->getHeight();
+
+    if (shift.getX() == 0 && shift.getY() == 0) {
+        return false;
+    }
+
+    bool scrolled = false;
+
+    if (shift.getX() != 0 || std::abs(shift.getY()) >= height) {
+        for (int row = 0; row < height; row++) {
+            drawWindowRow(grid, row);
+        }
+    } else {
+        scrollWindow(shift.getY());
+        scrolled = true;
+
+        // Строки прокручиваются на всю ширину: справа от окна остаются сдвинутые остатки
+        int rightEdge = _offset.getX() + _viewport->getWidth() * 2 + 1;
+        for (int row = 0; row < height; row++) {
+            moveCursor(Position(rightEdge, _offset.getY() + row));
+            std::cout << "\033[0m\033[K";
+        }
+
+        int first = shift.getY() > 0 ? height - shift.getY() : 0;
+        int last = shift.getY() > 0 ? height : -shift.getY();
+        for (int row = first; row < last; row++) {
+            drawWindowRow(grid, row);
+        }
+    }
+    return scrolled;
+}
+
+Position ConsoleRenderer::minimapOrigin() const {
+    return Position(_offset.getX() + _viewport->getWidth() * 2 + 3, _offset.getY());
+}
+
+void ConsoleRenderer::drawMinimapCell(const BlockAggregates& blocks, const Position& block) const {
+    // ANSI-цвета по доле оставшихся очков: пусто, мало, половина, почти нетронут
+    static const int densityColors[4] = {0, 4, 2, 3};
+    const int playerColor = 1;
+
+    int column = block.getX();
+    int top = block.getY() - block.getY() % 2;
+    int colors[2] = {-1, -1};
+
+    for (int i = 0; i < 2; i++) {
+        int row = top + i;
+        if (row >= blocks.getBlocksY()) {
+            continue;
+        }
+        if (Position(column, row) == _minimapPlayerBlock) {
+            colors[i] = playerColor;
+            continue;
+        }
+
+        const BlockStats& stats = blocks.at(column, row);
+        int level = 0;
+        if (stats.initialValue > 0 && stats.remainingValue > 0) {
+            level = 1 + static_cast<int>(3 * stats.remainingValue / (stats.initialValue + 1));
+        }
+        colors[i] = densityColors[level];
+    }
+
+    Position origin = minimapOrigin();
+    moveCursor(Position(origin.getX() + column, origin.getY() + 1 + top / 2));
+    std::cout << "\033[" << (colors[0] < 0 ? 39 : 30 + colors[0]) << ";"
+              << (colors[1] < 0 ? 49 : 40 + colors[1]) << "m\u2580" << _colorCodes.at(Color::DEFAULT);
+}
+
+void ConsoleRenderer::drawMinimapBombs(const BlockAggregates& blocks) const {
+    Position origin = minimapOrigin();
+    moveCursor(Position(origin.getX(), origin.getY() + 1 + (blocks.getBlocksY() + 1) / 2));
+    std::cout << "\033[1;31mB\033[0m " << blocks.getBombsLeft() << "\033[K";
+}
+
+void ConsoleRenderer::drawMinimap(BlockAggregates& blocks, const Position& playerPos) {
+    _minimapPlayerBlock = blocks.blockOf(playerPos);
+
+    moveCursor(minimapOrigin());
+    std::cout << "\033[1;36mMap\033[0m";
+
+    for (int row = 0; row < blocks.getBlocksY(); row += 2) {
+        for (int column = 0; column < blocks.getBlocksX(); column++) {
+            drawMinimapCell(blocks, Position(column, row));
+        }
+    }
+    drawMinimapBombs(blocks);
+
+    blocks.clearDirty();
+}
+
+void ConsoleRenderer::updateMinimap(BlockAggregates& blocks, const Position& playerPos) {
+    Position previousBlock = _minimapPlayerBlock;
+    _minimapPlayerBlock = blocks.blockOf(playerPos);
+
+    for (int index: blocks.getDirtyBlocks()) {
+        drawMinimapCell(blocks, Position(index % blocks.getBlocksX(), index / blocks.getBlocksX()));
+    }
+    if (previousBlock.getX() >= 0 && !(previousBlock == _minimapPlayerBlock)) {
+        drawMinimapCell(blocks, previousBlock);
+    }
+    drawMinimapCell(blocks, _minimapPlayerBlock);
+
+    if (!blocks.getDirtyBlocks().empty()) {
+        drawMinimapBombs(blocks);
+    }
+
+    blocks.clearDirty();
 }
 
 void ConsoleRenderer::drawPlayer(const Position& playerPos) {
-    Position drawPos = Position(_offset.getX() + playerPos.getX() * 2, _offset.getY() + playerPos.getY());
+    if (!_viewport->contains(playerPos)) {
+        return;
+    }
+
+    Position drawPos = toScreen(playerPos);
     moveCursor(drawPos);
     std::cout << _colorCodes.at(Color::DEFAULT) << _playerSymbol << _colorCodes.at(Color::DEFAULT);
-    std::cout.flush();
 }
 
 void ConsoleRenderer::drawMove(const Grid& grid, const std::vector<Position>& affectedElements) {
     for (const Position& pos: affectedElements) {
-        Position drawPos = Position(_offset.getX() + pos.getX() * 2, _offset.getY() + pos.getY());
+        if (!_viewport->contains(pos)) {
+            continue;
+        }
+
+        Position drawPos = toScreen(pos);
         
         moveCursor(drawPos);
         std::cout << "\033[47m";
         grid[pos].acceptRender(*this, drawPos);
         std::cout <<_colorCodes.at(Color::DEFAULT);
     }
-
-    std::cout.flush();
 } 
 
 void ConsoleRenderer::highlightMoveDirection(const Grid& grid, std::vector<std::pair<bool, Position>>& availableMoves, Direction direction) {
     for (std::pair<bool, Position> elem: availableMoves) {
-        if (elem.first) {
-            Position drawPos =  Position(_offset.getX() + elem.second.getX() * 2, _offset.getY() + elem.second.getY());
+        if (elem.first && _viewport->contains(elem.second)) {
+            Position drawPos = toScreen(elem.second);
             moveCursor(drawPos);
             std::cout << "\033[47m";
             grid[elem.second].acceptRender(*this, drawPos);
@@ -249,19 +391,17 @@ void ConsoleRenderer::highlightMoveDirection(const Grid& grid, std::vector<std::
     }
     
     int index = static_cast<int>(direction);
-    if (index >= 0 && index < 4 && availableMoves[index].first) {
+    if (index >= 0 && index < 4 && availableMoves[index].first && _viewport->contains(availableMoves[index].second)) {
         Position highlightedCellPos = availableMoves[index].second;
-        Position drawPos = Position(_offset.getX() + highlightedCellPos.getX() * 2, _offset.getY() + highlightedCellPos.getY());
+        Position drawPos = toScreen(highlightedCellPos);
         moveCursor(drawPos);
         grid[highlightedCellPos].acceptRender(*this, drawPos, Color::BLUEHIGHLIGHT); 
     }
-
-    std::cout.flush();
 }
 
 void ConsoleRenderer::drawScoreAtPosition(int score, const Position& pos) const {
     moveCursor(pos);
-    std::string scoreColor;
+    const char* scoreColor;
     if (score >= 0 && score <= 100) {
         scoreColor = "\033[1;31m";
     } else if (score >= 101 && score <= 200) {
@@ -270,14 +410,50 @@ void ConsoleRenderer::drawScoreAtPosition(int score, const Position& pos) const
         scoreColor = "\033[1;32m";
     }
     
-    std::string scoreStr = std::to_string(score);
-    
-    if (scoreStr.length() < 3) {
-        scoreStr = std::string(3 - scoreStr.length(), ' ') + scoreStr;
+    // Выравнивание через setw вместо временных строк: счет рисуется на каждом ходу
+    std::cout << "\033[1;36mScore: " << scoreColor << std::setw(3) << score
+              << _colorCodes.at(Color::DEFAULT);
+}
+
+void ConsoleRenderer::drawStatusLine(const char* text) const {
+    TerminalSize w = TerminalGeometry::get();
+    int statusY = _offset.getY() + _viewport->getHeight() + 2;
+    if (statusY >= w.rows) {
+        return;
     }
-    
-    std::cout << "\033[1;36mScore: " << scoreColor << scoreStr << _colorCodes.at(Color::DEFAULT);
-    std::cout.flush();
+
+    size_t length = std::min(std::strlen(text), static_cast<size_t>(std::max(w.columns, 0)));
+    int statusX = (w.columns - static_cast<int>(length)) / 2;
+
+    moveCursor(Position(0, statusY));
+    std::cout << "\033[2K";
+    moveCursor(Position(statusX, statusY));
+    std::cout << "\033[90m";
+    std::cout.write(text, static_cast<std::streamsize>(length));
+    std::cout << _colorCodes.at(Color::DEFAULT);
+}
+
+void ConsoleRenderer::reserveSidePanel(bool reserved) {
+    _sidePanel = reserved;
+}
+
+bool ConsoleRenderer::drawSidePanel(const char* const lines[], int count, int width) const {
+    int panelX = _offset.getX() - 2 - width;
+    if (panelX < 0 || count > _viewport->getHeight()) {
+        return false;
+    }
+
+    std::cout << "\033[90m";
+    for (int i = 0; i < count; i++) {
+        moveCursor(Position(panelX, _offset.getY() + i));
+        int length = static_cast<int>(std::strlen(lines[i]));
+        std::cout.write(lines[i], std::min(length, width));
+        for (int pad = length; pad < width; pad++) {
+            std::cout.put(' ');
+        }
+    }
+    std::cout << _colorCodes.at(Color::DEFAULT);
+    return true;
 }
 
 void ConsoleRenderer::clearScreen() const {
@@ -287,10 +463,9 @@ void ConsoleRenderer::clearScreen() const {
 
 void ConsoleRenderer::resetCursor() const {
     showCursor();
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
+    TerminalSize w = TerminalGeometry::get();
     
-    moveCursor(Position(0, w.ws_row - 1));
+    moveCursor(Position(0, w.rows - 1));
     std::cout.flush();
 }
 
@@ -298,10 +473,9 @@ void ConsoleRenderer::displayWelcomeScreen() const {
 
     clearScreen();
     
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-    int terminalWidth = w.ws_col;
-    int terminalHeight = w.ws_row;
+    TerminalSize w = TerminalGeometry::get();
+    int terminalWidth = w.columns;
+    int terminalHeight = w.rows;
     
     std::vector<std::string> titleLines = {
         " ######   ########  ########  ########  ######  ",
@@ -336,10 +510,9 @@ void ConsoleRenderer::displayWelcomeScreen() const {
 void ConsoleRenderer::displayGameOver() const {
     clearScreen();
     
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-    int terminalWidth = w.ws_col;
-    int terminalHeight = w.ws_row;
+    TerminalSize w = TerminalGeometry::get();
+    int terminalWidth = w.columns;
+    int terminalHeight = w.rows;
     
     int verticalPadding = terminalHeight / 3;
     for (int i = 0; i < verticalPadding; i++) {
@@ -354,12 +527,13 @@ void ConsoleRenderer::displayGameOver() const {
 }
 
 void ConsoleRenderer::highlightGameOverState(const Grid& grid) {
-    int gridWidth = grid.getWidth();
-    int gridHeight = grid.getHeight();
+    int gridWidth = _viewport->getWidth();
+    int gridHeight = _viewport->getHeight();
+    Position origin = _viewport->getOrigin();
 
     for (int row = 0; row < gridHeight; row++) {
         for (int col = 0; col < gridWidth; col++) {
-            const Position& cellPos = Position(col, row);
+            const Position& cellPos = Position(origin.getX() + col, origin.getY() + row);
             const ICell& cell = grid[cellPos];
             
             Position drawPos = Position(_offset.getX() + col * 2, _offset.getY() + row);
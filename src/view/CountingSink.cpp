@@ -0,0 +1,39 @@
+#include "view/CountingSink.hpp"
+
+const size_t CountingSink::BUFFER_SIZE;
+
+CountingSink::CountingSink(): _bytes(0), _writes(0) {
+    setp(_buffer, _buffer + BUFFER_SIZE);
+}
+
+unsigned long long CountingSink::getBytes() const {
+    return _bytes + static_cast<unsigned long long>(pptr() - pbase());
+}
+
+CountingSink::int_type CountingSink::overflow(int_type ch) {
+    drain();
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+        return traits_type::not_eof(ch);
+    }
+
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+int CountingSink::sync() {
+    drain();
+    return 0;
+}
+
+void CountingSink::drain() {
+    std::ptrdiff_t pending = pptr() - pbase();
+    if (pending > 0) {
+        _bytes += static_cast<unsigned long long>(pending);
+        _writes++;
+        consume(pbase(), static_cast<size_t>(pending));
+    }
+    setp(_buffer, _buffer + BUFFER_SIZE);
+}
+
+void CountingSink::consume(const char*, size_t) {}
@@ -1,100 +1,207 @@
 #include "view/GameView.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/Tracer.hpp"
 #include "model/GameModel.hpp"
 #include "core/Directions.hpp"
 #include <iostream>
 #include <iomanip>
-#include <signal.h>
 #include <chrono>
-#include <sys/ioctl.h>
 #include <unistd.h>
 
-static GameView* globalGameView = nullptr;
+const int GameView::FRAME_INTERVAL_MS;
 
-void handleResize(int sig) {
-    if (globalGameView && sig == SIGWINCH) {
-        globalGameView->refresh();
+GameView::GameView(GameModel* model): _model(model), _showMinimap(false), _fieldOffset(0, 0), _layoutGeneration(0),
+    _rendering(false), _highlightShown(false), _latencyOverlay(false), _statsOverlay(false),
+    _previousOutput(nullptr), _output(nullptr), _posted(0), _presented(0), _dropped(0) {
+    // Вывод идет через счетчик байт, чтобы панель показателей видела объем кадров и в терминале
+    _output = dynamic_cast<CountingSink*>(std::cout.rdbuf());
+    if (_output == nullptr) {
+        std::cout.flush();
+        _terminalSink = std::make_unique<TerminalSink>(STDOUT_FILENO);
+        _previousOutput = std::cout.rdbuf(_terminalSink.get());
+        _output = _terminalSink.get();
     }
-}
 
-GameView::GameView(GameModel* model): _model(model) {
     _settings = std::make_unique<Settings>();
-    
-    Position offset = _settings->calculateCenteringOffsets(
+    _viewport = std::make_unique<Viewport>(
+        _model->getGrid().getWidth(),
+        _model->getGrid().getHeight(),
         _model->getGrid().getWidth(),
         _model->getGrid().getHeight()
     );
     
-    _renderer = std::make_unique<ConsoleRenderer>(offset);
+    updateRenderer();
     
     std::cout << "\033[?7l";
     std::cout << "\033[?1049h";
     
-    struct sigaction sa;
-    sa.sa_handler = handleResize;
-    sigemptyset(&sa.sa_mask);
-    sa.sa_flags = 0;
-    sigaction(SIGWINCH, &sa, nullptr);
-    
-    globalGameView = this;
+    _resizeWatcher = std::make_unique<ResizeWatcher>();
+    _frameMoves.reserve(64);
+    _pendingCells.reserve(256);
+    _highlightMoves.reserve(4);
 }
 
 GameView::~GameView() {
+    stopRendering();
     std::cout << "\033[?7h";
     std::cout << "\033[?1049l";
+    if (_terminalSink) {
+        std::cout.flush();
+        std::cout.rdbuf(_previousOutput);
+    }
 }
 
 void GameView::updateRenderer() {
-    Position offset = _settings->calculateCenteringOffsets(
-        _model->getGrid().getWidth(),
-        _model->getGrid().getHeight()
+    int gridWidth = _model->getGrid().getWidth();
+    int gridHeight = _model->getGrid().getHeight();
+    const BlockAggregates& blocks = _model->getBlockAggregates();
+
+    Position windowSize = _settings->calculateViewportSize(gridWidth, gridHeight);
+    _showMinimap = windowSize.getX() < gridWidth || windowSize.getY() < gridHeight;
+
+    // Миникарта: по символу на блок, строка заголовка и строка бомб, отступ от поля
+    int minimapColumns = blocks.getBlocksX() + 3;
+    if (_showMinimap) {
+        windowSize = _settings->calculateViewportSize(gridWidth, gridHeight, minimapColumns);
+        _showMinimap = windowSize.getY() >= (blocks.getBlocksY() + 1) / 2 + 2 && windowSize.getX() > 0;
+        if (!_showMinimap) {
+            windowSize = _settings->calculateViewportSize(gridWidth, gridHeight);
+        }
+    }
+
+    _viewport->resize(windowSize.getX(), windowSize.getY());
+    _viewport->centerOn(_model->getPlayerPosition());
+    _model->setViewExtent(_viewport->getWidth(), _viewport->getHeight());
+
+    int reservedCells = _showMinimap ? (minimapColumns + 1) / 2 : 0;
+    _fieldOffset = _settings->calculateCenteringOffsets(
+        _viewport->getWidth() + reservedCells,
+        _viewport->getHeight()
     );
-    _renderer = std::make_unique<ConsoleRenderer>(offset);
+    if (_renderer) {
+        _renderer->relayout(_fieldOffset);
+    } else {
+        _renderer = std::make_unique<ConsoleRenderer>(_fieldOffset, _viewport.get());
+    }
+    _layoutGeneration = TerminalGeometry::getGeneration();
+}
+
+void GameView::renderMinimap() {
+    if (_showMinimap) {
+        _renderer->drawMinimap(_model->getBlockAggregates(), _model->getPlayerPosition());
+    } else {
+        _model->getBlockAggregates().clearDirty();
+    }
 }
 
 void GameView::renderStatringState() {
     _renderer->clearScreen();
     _renderer->drawStartingState(_model->getGrid());
     _renderer->drawPlayer(_model->getPlayerPosition());
+    renderMinimap();
     renderScore();
+    std::cout.flush();
+}
+
+void GameView::renderMove(const MoveTiming& timing) {
+    GREED_ALLOCATION_PHASE(RENDER);
+    if (timing.isSet()) {
+        LatencyMonitor& latency = LatencyMonitor::instance();
+        latency.record(LatencyMonitor::INPUT, timing.readTime, timing.decodedTime);
+        latency.record(LatencyMonitor::MODEL, timing.decodedTime, timing.appliedTime);
+    }
+
+    if (!_rendering) {
+        presentMove(_model->getAffectedElements());
+        std::cout.flush();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_modelMutex);
+        const std::vector<Position>& affected = _model->getAffectedElements();
+        _pendingCells.insert(_pendingCells.end(), affected.begin(), affected.end());
+    }
+
+    RenderRequest request;
+    request.kind = RenderRequest::MOVE;
+    request.timing = timing;
+    post(request);
+}
+
+void GameView::toggleLatencyOverlay() {
+    _latencyOverlay = !_latencyOverlay;
+    refresh();
+}
+
+void GameView::renderLatencyOverlay() {
+    if (_latencyOverlay) {
+        char line[256];
+        LatencyMonitor::instance().summary(line, sizeof(line));
+        _renderer->drawStatusLine(line);
+    }
+}
+
+void GameView::toggleStatsOverlay() {
+    _statsOverlay = !_statsOverlay;
+    refresh();
 }
 
-void GameView::renderMove() {
-    _renderer->drawMove(_model->getGrid(), _model->getAffectedElements());
+void GameView::renderStatsOverlay() {
+    if (!_statsOverlay) {
+        return;
+    }
+
+    _stats.sample(std::chrono::steady_clock::now());
+    RuntimeStats::Lines lines;
+    _stats.format(lines);
+    const char* rows[RuntimeStats::LINE_COUNT];
+    for (int i = 0; i < RuntimeStats::LINE_COUNT; i++) {
+        rows[i] = lines[i];
+    }
+
+    if (!_renderer->drawSidePanel(rows, RuntimeStats::LINE_COUNT, RuntimeStats::LINE_WIDTH) && !_latencyOverlay) {
+        char line[128];
+        _stats.formatLine(line, sizeof(line));
+        _renderer->drawStatusLine(line);
+    }
+}
+
+void GameView::presentMove(const std::vector<Position>& affectedElements) {
+    bool scrolled = _renderer->followPlayer(_model->getGrid(), _model->getPlayerPosition());
+    _renderer->drawMove(_model->getGrid(), affectedElements);
     _renderer->drawPlayer(_model->getPlayerPosition());
+    if (_showMinimap && scrolled) {
+        // Прокрутка области сдвигает строки целиком вместе с миникартой
+        _renderer->drawMinimap(_model->getBlockAggregates(), _model->getPlayerPosition());
+    } else if (_showMinimap) {
+        _renderer->updateMinimap(_model->getBlockAggregates(), _model->getPlayerPosition());
+    } else {
+        _model->getBlockAggregates().clearDirty();
+    }
     renderScore();
+    renderLatencyOverlay();
+    renderStatsOverlay();
 }
 
 void GameView::highlightGameOver() {
     _renderer->highlightGameOverState(_model->getGrid());
     _renderer->drawPlayer(_model->getPlayerPosition());
     
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-    int terminalWidth = w.ws_col;
-    
-    int gridWidth = _model->getGrid().getWidth() * 2;
-    Position fieldOffset = _settings->calculateCenteringOffsets(
-        _model->getGrid().getWidth(),
-        _model->getGrid().getHeight()
-    );
+    int gridWidth = _viewport->getWidth() * 2;
+    Position fieldOffset = _fieldOffset;
     
     int scoreX = fieldOffset.getX() + (gridWidth / 2) - 3;
     int scoreY = fieldOffset.getY() - 2;
     
     Position scorePos(scoreX, scoreY);
     _renderer->drawScoreAtPosition(_model->getScore(), scorePos);
+    std::cout.flush();
 }
 
 void GameView::renderScore() {
-struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
-    int terminalWidth = w.ws_col;
-    
-    int gridWidth = _model->getGrid().getWidth() * 2;
-    Position fieldOffset = _settings->calculateCenteringOffsets(
-        _model->getGrid().getWidth(),
-        _model->getGrid().getHeight()
-    );
+    int gridWidth = _viewport->getWidth() * 2;
+    Position fieldOffset = _fieldOffset;
     
     int scoreX = fieldOffset.getX() + (gridWidth / 2) - 4;
     int scoreY = fieldOffset.getY() - 2;
@@ -107,7 +214,20 @@ struct winsize w;
 }
 
 void GameView::highlightMoveDirection(std::vector<std::pair<bool, Position>>& availableMoves, Direction direction) {
-    _renderer->highlightMoveDirection(_model->getGrid(), availableMoves, direction);
+    GREED_ALLOCATION_PHASE(RENDER);
+    if (!_rendering) {
+        _renderer->highlightMoveDirection(_model->getGrid(), availableMoves, direction);
+        std::cout.flush();
+        return;
+    }
+
+    RenderRequest request;
+    request.kind = RenderRequest::HIGHLIGHT;
+    request.direction = direction;
+    for (size_t i = 0; i < 4 && i < availableMoves.size(); i++) {
+        request.moves[i] = availableMoves[i];
+    }
+    post(request);
 //    renderScore();
 }
 
@@ -122,17 +242,209 @@ void GameView::displayWelcomeScreen() {
 
 void GameView::displayMenu(const std::vector<std::string>& menuItems, int selectedIndex) {}
 
+bool GameView::handlePendingResize() {
+    if (!_resizeWatcher->poll()) {
+        return false;
+    }
+
+    refresh();
+    return true;
+}
+
+void GameView::startRendering() {
+    if (_rendering) {
+        return;
+    }
+
+    _rendering = true;
+    _renderThread = std::thread(&GameView::renderLoop, this);
+}
+
+void GameView::stopRendering() {
+    if (!_rendering) {
+        return;
+    }
+
+    RenderRequest request;
+    request.kind = RenderRequest::STOP;
+    while (!_requests.push(request)) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _posted++;
+    }
+    _wake.notify_one();
+
+    _renderThread.join();
+    _rendering = false;
+}
+
+void GameView::waitForIdle() {
+    if (!_rendering) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    _idle.wait(lock, [this] { return _presented >= _posted; });
+}
+
+std::unique_lock<std::mutex> GameView::lockModel() {
+    return std::unique_lock<std::mutex>(_modelMutex);
+}
+
+void GameView::post(const RenderRequest& request) {
+    bool pushed = _requests.push(request);
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _posted++;
+        if (!pushed) {
+            _dropped++;
+        }
+    }
+    _wake.notify_one();
+}
+
+void GameView::renderLoop() {
+    GREED_TRACE_THREAD("render");
+    auto nextFrame = std::chrono::steady_clock::now();
+    bool running = true;
+
+    while (running) {
+        unsigned long long dropped = 0;
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wake.wait(lock, [this] { return !_requests.empty() || _dropped > 0; });
+        }
+
+        // Запросы, пришедшие до начала кадра, попадают в него же
+        std::this_thread::sleep_until(nextFrame);
+        auto frameStart = std::chrono::steady_clock::now();
+        unsigned long long bytesBefore = _output != nullptr ? _output->getBytes() : 0;
+        LatencyMonitor& latency = LatencyMonitor::instance();
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            dropped = _dropped;
+            _dropped = 0;
+        }
+
+        bool full = dropped > 0;
+        bool moved = false;
+        bool highlight = false;
+        RenderRequest highlightRequest;
+        RenderRequest request;
+        unsigned long long handled = dropped;
+
+        while (_requests.pop(request)) {
+            handled++;
+            switch (request.kind) {
+                case RenderRequest::MOVE:
+                    moved = true;
+                    highlight = false;
+                    if (request.timing.isSet() && _frameMoves.size() < _frameMoves.capacity()) {
+                        latency.record(LatencyMonitor::QUEUE, request.timing.appliedTime, frameStart);
+                        _frameMoves.push_back(request.timing.readTime);
+                    }
+                    break;
+                case RenderRequest::HIGHLIGHT:
+                    highlight = true;
+                    highlightRequest = request;
+                    break;
+                case RenderRequest::REFRESH:
+                    full = true;
+                    highlight = false;
+                    break;
+                case RenderRequest::STOP:
+                    running = false;
+                    break;
+            }
+        }
+
+        {
+            GREED_TRACE_SCOPE("view", "frame");
+            GREED_ALLOCATION_PHASE(RENDER);
+            std::lock_guard<std::mutex> lock(_modelMutex);
+            if (full) {
+                refreshNow();
+            } else if (moved) {
+                if (_highlightShown) {
+                    // Подсветка прошлого кадра могла смениться в этом кадре и не совпасть с путем хода
+                    for (const std::pair<bool, Position>& move: _highlightMoves) {
+                        if (move.first) {
+                            _pendingCells.push_back(move.second);
+                        }
+                    }
+                }
+                presentMove(_pendingCells);
+            }
+            _pendingCells.clear();
+            if (full || moved) {
+                _highlightShown = false;
+            }
+
+            if (highlight) {
+                _highlightMoves.assign(highlightRequest.moves, highlightRequest.moves + 4);
+                _renderer->highlightMoveDirection(_model->getGrid(), _highlightMoves, highlightRequest.direction);
+                _highlightShown = true;
+            }
+            auto frameBuilt = std::chrono::steady_clock::now();
+            {
+                GREED_TRACE_SCOPE("view", "flush");
+                std::cout.flush();
+            }
+            auto frameWritten = std::chrono::steady_clock::now();
+
+            // Кадр общий для всех объединенных в нем ходов: каждый получает его задержки
+            for (const std::chrono::steady_clock::time_point& readTime: _frameMoves) {
+                latency.record(LatencyMonitor::BUILD, frameStart, frameBuilt);
+                latency.record(LatencyMonitor::WRITE, frameBuilt, frameWritten);
+                latency.record(LatencyMonitor::TOTAL, readTime, frameWritten);
+                _stats.recordMove(std::chrono::duration_cast<std::chrono::nanoseconds>(frameWritten - readTime).count());
+            }
+            _stats.recordFrame(std::chrono::duration_cast<std::chrono::nanoseconds>(frameWritten - frameStart).count(),
+                _output != nullptr ? static_cast<long long>(_output->getBytes() - bytesBefore) : -1);
+            _frameMoves.clear();
+        }
+        nextFrame = std::chrono::steady_clock::now() + std::chrono::milliseconds(FRAME_INTERVAL_MS);
+
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _presented += handled;
+        }
+        _idle.notify_all();
+    }
+}
+
 void GameView::refresh() {
+    if (_rendering) {
+        RenderRequest request;
+        request.kind = RenderRequest::REFRESH;
+        post(request);
+        return;
+    }
+
+    refreshNow();
+}
+
+void GameView::refreshNow() {
+    GREED_TRACE_SCOPE("view", "refresh");
+    GREED_ALLOCATION_PHASE(RENDER);
     std::cout << "\033[2J\033[1;1H";
     
     try {
         _settings->updateTerminalSize();
-        updateRenderer();
+        if (_layoutGeneration != TerminalGeometry::getGeneration()) {
+            updateRenderer();
+        }
         
+        _renderer->reserveSidePanel(_statsOverlay);
         _renderer->drawStartingState(_model->getGrid());
         _renderer->drawPlayer(_model->getPlayerPosition());
+        renderMinimap();
         
         renderScore();
+        renderLatencyOverlay();
+        renderStatsOverlay();
         
     } catch (...) {
         system("clear");
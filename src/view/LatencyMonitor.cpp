@@ -0,0 +1,114 @@
+#include "view/LatencyMonitor.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+LatencyMonitor& LatencyMonitor::instance() {
+    static LatencyMonitor monitor;
+    return monitor;
+}
+
+const char* LatencyMonitor::phaseName(Phase phase) {
+    switch (phase) {
+        case INPUT:
+            return "input";
+        case MODEL:
+            return "model";
+        case QUEUE:
+            return "queue";
+        case BUILD:
+            return "build";
+        case WRITE:
+            return "write";
+        case TOTAL:
+            return "total";
+        default:
+            return "unknown";
+    }
+}
+
+void LatencyMonitor::record(Phase phase, std::chrono::steady_clock::time_point from,
+    std::chrono::steady_clock::time_point to) {
+    long long nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+    _phases[phase].record(nanoseconds > 0 ? static_cast<uint64_t>(nanoseconds) : 0);
+}
+
+void LatencyMonitor::reset() {
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        _phases[i].reset();
+    }
+}
+
+void LatencyMonitor::summary(char* buffer, size_t size) const {
+    if (size == 0) {
+        return;
+    }
+
+    size_t used = 0;
+    auto append = [&](int written) {
+        if (written > 0) {
+            used = std::min(size - 1, used + static_cast<size_t>(written));
+        }
+    };
+
+    append(std::snprintf(buffer, size, "p50/p99 ms"));
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        const LatencyHistogram& histogram = _phases[i];
+        append(std::snprintf(buffer + used, size - used, "  %s %.2f/%.2f", phaseName(static_cast<Phase>(i)),
+            histogram.percentile(50) / 1e6, histogram.percentile(99) / 1e6));
+    }
+    append(std::snprintf(buffer + used, size - used, "  n=%llu",
+        static_cast<unsigned long long>(_phases[TOTAL].getCount())));
+}
+
+bool LatencyMonitor::dump(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "# Key-to-screen latency, microseconds\n";
+    file << std::left << std::setw(8) << "phase" << std::right
+         << std::setw(10) << "count" << std::setw(12) << "mean" << std::setw(12) << "p50"
+         << std::setw(12) << "p90" << std::setw(12) << "p99" << std::setw(12) << "p99.9"
+         << std::setw(12) << "max" << "\n";
+
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        const LatencyHistogram& histogram = _phases[i];
+        file << std::left << std::setw(8) << phaseName(static_cast<Phase>(i)) << std::right
+             << std::setw(10) << histogram.getCount()
+             << std::setw(12) << histogram.getMean() / 1e3
+             << std::setw(12) << histogram.percentile(50) / 1e3
+             << std::setw(12) << histogram.percentile(90) / 1e3
+             << std::setw(12) << histogram.percentile(99) / 1e3
+             << std::setw(12) << histogram.percentile(99.9) / 1e3
+             << std::setw(12) << histogram.getMax() / 1e3 << "\n";
+    }
+
+    // Непустые корзины: по ним распределение строится заново без потери точности
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        const LatencyHistogram& histogram = _phases[i];
+        uint64_t count = histogram.getCount();
+        if (count == 0) {
+            continue;
+        }
+
+        file << "\n# " << phaseName(static_cast<Phase>(i)) << ": lower_us upper_us count cumulative\n";
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; bucket++) {
+            uint64_t bucketCount = histogram.getBucketCount(bucket);
+            if (bucketCount == 0) {
+                continue;
+            }
+            seen += bucketCount;
+            file << LatencyHistogram::bucketLowerBound(bucket) / 1e3 << " "
+                 << LatencyHistogram::bucketUpperBound(bucket) / 1e3 << " "
+                 << bucketCount << " "
+                 << static_cast<double>(seen) / static_cast<double>(count) << "\n";
+        }
+    }
+
+    return file.good();
+}
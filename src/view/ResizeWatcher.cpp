@@ -0,0 +1,75 @@
+#include "view/ResizeWatcher.hpp"
+#include "view/TerminalGeometry.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+volatile sig_atomic_t signalWriteFd = -1;
+}
+
+const int ResizeWatcher::SETTLE_MS;
+
+ResizeWatcher::ResizeWatcher(): _readFd(-1), _writeFd(-1), _pending(false) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw std::runtime_error("Failed to create resize pipe");
+    }
+
+    for (int fd: fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    _readFd = fds[0];
+    _writeFd = fds[1];
+
+    signalWriteFd = _writeFd;
+
+    struct sigaction sa;
+    sa.sa_handler = onSignal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGWINCH, &sa, &_previousAction);
+}
+
+ResizeWatcher::~ResizeWatcher() {
+    sigaction(SIGWINCH, &_previousAction, nullptr);
+    signalWriteFd = -1;
+
+    close(_readFd);
+    close(_writeFd);
+}
+
+void ResizeWatcher::onSignal(int sig) {
+    int savedErrno = errno;
+    TerminalGeometry::onResizeSignal(sig);
+    int fd = signalWriteFd;
+    if (fd >= 0 && sig == SIGWINCH) {
+        char byte = 1;
+        ssize_t written = write(fd, &byte, 1);
+        (void)written;
+    }
+    errno = savedErrno;
+}
+
+bool ResizeWatcher::poll() {
+    char buffer[64];
+    bool signalled = false;
+    while (read(_readFd, buffer, sizeof(buffer)) > 0) {
+        signalled = true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (signalled) {
+        _pending = true;
+        _lastSignal = now;
+        return false;
+    }
+
+    if (!_pending || now - _lastSignal < std::chrono::milliseconds(SETTLE_MS)) {
+        return false;
+    }
+    _pending = false;
+    return true;
+}
@@ -0,0 +1,155 @@
+#include "view/RuntimeStats.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+const int RuntimeStats::FRAME_WINDOW;
+const int RuntimeStats::SAMPLE_INTERVAL_MS;
+const int RuntimeStats::VALUE_COUNT;
+const int RuntimeStats::LINE_COUNT;
+const int RuntimeStats::LINE_WIDTH;
+const int RuntimeStats::LABEL_WIDTH;
+const int RuntimeStats::VALUE_SIZE;
+const char* const RuntimeStats::LABELS[RuntimeStats::VALUE_COUNT] = {"move", "moves/s", "frame", "bytes", "heap", "rss"};
+
+namespace {
+
+/**
+ * @brief Записывает размер в мегабайтах
+ * @param buffer Буфер значения
+ * @param bytes Байты (-1 - недоступно)
+ */
+void formatMegabytes(char (&buffer)[RuntimeStats::VALUE_SIZE], long long bytes) {
+    if (bytes < 0) {
+        std::snprintf(buffer, sizeof(buffer), "n/a");
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.1f MB", bytes / (1024.0 * 1024.0));
+    }
+}
+
+/**
+ * @brief Записывает время в миллисекундах
+ * @param buffer Буфер значения
+ * @param ns Наносекунды (-1 - замеров не было)
+ */
+void formatMilliseconds(char (&buffer)[RuntimeStats::VALUE_SIZE], long long ns) {
+    if (ns < 0) {
+        std::snprintf(buffer, sizeof(buffer), "-");
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+    }
+}
+
+} // namespace
+
+RuntimeStats::RuntimeStats(): _lastMoveNs(-1), _lastFrameBytes(-1), _frameNs(), _frameCount(0), _frameNext(0),
+    _frameSum(0), _moves(0), _sampledMoves(0), _movesPerSecond(0), _heapBytes(-1), _residentBytes(-1) {}
+
+void RuntimeStats::recordMove(long long latencyNs) {
+    _lastMoveNs = latencyNs > 0 ? latencyNs : 0;
+    _moves++;
+}
+
+void RuntimeStats::recordFrame(long long frameNs, long long bytes) {
+    if (frameNs < 0) {
+        frameNs = 0;
+    }
+    if (_frameCount == FRAME_WINDOW) {
+        _frameSum -= _frameNs[_frameNext];
+    } else {
+        _frameCount++;
+    }
+    _frameNs[_frameNext] = frameNs;
+    _frameSum += frameNs;
+    _frameNext = (_frameNext + 1) % FRAME_WINDOW;
+    _lastFrameBytes = bytes;
+}
+
+void RuntimeStats::sample(std::chrono::steady_clock::time_point now) {
+    bool sampled = _sampledAt != std::chrono::steady_clock::time_point();
+    if (sampled && now - _sampledAt < std::chrono::milliseconds(SAMPLE_INTERVAL_MS)) {
+        return;
+    }
+
+    if (sampled) {
+        double seconds = std::chrono::duration<double>(now - _sampledAt).count();
+        _movesPerSecond = seconds > 0 ? (_moves - _sampledMoves) / seconds : 0;
+    }
+    _sampledAt = now;
+    _sampledMoves = _moves;
+    _heapBytes = heapBytes();
+    _residentBytes = residentBytes();
+}
+
+long long RuntimeStats::averageFrameNs() const {
+    return _frameCount > 0 ? _frameSum / _frameCount : -1;
+}
+
+void RuntimeStats::values(Values& values) const {
+    formatMilliseconds(values[0], _lastMoveNs);
+    std::snprintf(values[1], sizeof(values[1]), "%.1f", _movesPerSecond);
+    formatMilliseconds(values[2], averageFrameNs());
+    if (_lastFrameBytes < 0) {
+        std::snprintf(values[3], sizeof(values[3]), "n/a");
+    } else {
+        std::snprintf(values[3], sizeof(values[3]), "%lld B", _lastFrameBytes);
+    }
+    formatMegabytes(values[4], _heapBytes);
+    formatMegabytes(values[5], _residentBytes);
+}
+
+void RuntimeStats::format(Lines& lines) const {
+    Values current;
+    values(current);
+
+    std::snprintf(lines[0], sizeof(lines[0]), "%-*s", LINE_WIDTH, "STATS (I - hide)");
+    // Точность ограничивает подпись и значение шириной строки: длинное значение обрезается, а не переносится
+    const int valueWidth = LINE_WIDTH - LABEL_WIDTH;
+    for (int i = 0; i < VALUE_COUNT; i++) {
+        std::snprintf(lines[i + 1], sizeof(lines[i + 1]), "%-*.*s%*.*s",
+            LABEL_WIDTH, LABEL_WIDTH, LABELS[i], valueWidth, valueWidth, current[i]);
+    }
+}
+
+void RuntimeStats::formatLine(char* buffer, size_t size) const {
+    Values current;
+    values(current);
+
+    std::snprintf(buffer, size, "move %s | %s moves/s | frame %s | %s | heap %s | rss %s",
+        current[0], current[1], current[2], current[3], current[4], current[5]);
+}
+
+long long RuntimeStats::heapBytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<long long>(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+long long RuntimeStats::residentBytes() {
+    int fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    char buffer[128];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length <= 0) {
+        return -1;
+    }
+    buffer[length] = '\0';
+
+    // statm: размер, резидентные страницы, ...
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    if (std::sscanf(buffer, "%llu %llu", &size, &resident) != 2) {
+        return -1;
+    }
+    return static_cast<long long>(resident) * sysconf(_SC_PAGESIZE);
+}
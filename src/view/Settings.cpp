@@ -1,19 +1,20 @@
 #include "view/Settings.hpp"
+#include "view/TerminalGeometry.hpp"
 #include <unistd.h>
-#include <sys/ioctl.h>
+#include <algorithm>
+#include <stdexcept>
 
 Settings::Settings(int minWidth, int minHeight): _minWidth(52), _minHeight(27) {
     updateTerminalSize();
 };
 
 void Settings::updateTerminalSize() {
-    struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
+    TerminalSize w = TerminalGeometry::get();
 
-    _terminalWidth = w.ws_col;
-    _terminalHeight = w.ws_row;
+    _terminalWidth = w.columns;
+    _terminalHeight = w.rows;
 
-    if (_terminalWidth < 80 || _terminalHeight < 30) {
+    if (_terminalWidth < _minWidth || _terminalHeight < _minHeight) {
         throw std::runtime_error("Terminal too small");
     }
 }
@@ -27,4 +28,10 @@ Position Settings::calculateCenteringOffsets(int gridWidth, int gridHeight) {
     return Position(offsetX, offsetY);
 }
 
+Position Settings::calculateViewportSize(int gridWidth, int gridHeight, int reservedColumns) const {
+    // Строка счета, отступ и рамка сверху; рамка, отступ и строка управления снизу
+    int columns = (_terminalWidth - 4 - reservedColumns) / 2;
+    int rows = _terminalHeight - 7;
 
+    return Position(std::min(gridWidth, columns), std::min(gridHeight, rows));
+}
@@ -0,0 +1,57 @@
+#include "view/TerminalGeometry.hpp"
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+std::atomic<int> TerminalGeometry::_stale(1);
+std::mutex TerminalGeometry::_mutex;
+TerminalSize TerminalGeometry::_size = {TerminalGeometry::FALLBACK_COLUMNS, TerminalGeometry::FALLBACK_ROWS};
+std::atomic<unsigned> TerminalGeometry::_generation(0);
+bool TerminalGeometry::_fixed = false;
+
+const int TerminalGeometry::FALLBACK_COLUMNS;
+const int TerminalGeometry::FALLBACK_ROWS;
+
+TerminalSize TerminalGeometry::get() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Флаг сбрасывается до запроса: сигнал во время ioctl снова пометит кэш
+    if (!_fixed && _stale.exchange(0, std::memory_order_relaxed)) {
+        TerminalSize size = {FALLBACK_COLUMNS, FALLBACK_ROWS};
+        struct winsize w;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == 0 && w.ws_col > 0 && w.ws_row > 0) {
+            size.columns = w.ws_col;
+            size.rows = w.ws_row;
+        }
+
+        if (size.columns != _size.columns || size.rows != _size.rows) {
+            _size = size;
+            _generation++;
+        }
+    }
+    return _size;
+}
+
+unsigned TerminalGeometry::getGeneration() {
+    get();
+    return _generation.load();
+}
+
+void TerminalGeometry::onResizeSignal(int sig) {
+    if (sig == SIGWINCH) {
+        invalidate();
+    }
+}
+
+void TerminalGeometry::setFixedSize(TerminalSize size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _fixed = true;
+    if (size.columns != _size.columns || size.rows != _size.rows) {
+        _size = size;
+        _generation++;
+    }
+}
+
+void TerminalGeometry::releaseFixedSize() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _fixed = false;
+    invalidate();
+}
@@ -0,0 +1,19 @@
+#include "view/TerminalSink.hpp"
+#include <cerrno>
+#include <unistd.h>
+
+TerminalSink::TerminalSink(int fd): _fd(fd) {}
+
+void TerminalSink::consume(const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(_fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+}
@@ -0,0 +1,61 @@
+#include "view/Viewport.hpp"
+#include <algorithm>
+
+Viewport::Viewport(int boardWidth, int boardHeight, int width, int height):
+    _boardWidth(boardWidth), _boardHeight(boardHeight), _width(0), _height(0), _origin(0, 0) {
+    resize(width, height);
+}
+
+void Viewport::resize(int width, int height) {
+    _width = std::max(1, std::min(width, _boardWidth));
+    _height = std::max(1, std::min(height, _boardHeight));
+    clampOrigin();
+}
+
+void Viewport::centerOn(const Position& target) {
+    _origin = Position(target.getX() - _width / 2, target.getY() - _height / 2);
+    clampOrigin();
+}
+
+Position Viewport::follow(const Position& target) {
+    Position previous = _origin;
+    int marginX = _width / 4;
+    int marginY = _height / 4;
+    int x = _origin.getX();
+    int y = _origin.getY();
+
+    if (target.getX() < x + marginX) {
+        x = target.getX() - marginX;
+    } else if (target.getX() > x + _width - 1 - marginX) {
+        x = target.getX() - (_width - 1 - marginX);
+    }
+
+    if (target.getY() < y + marginY) {
+        y = target.getY() - marginY;
+    } else if (target.getY() > y + _height - 1 - marginY) {
+        y = target.getY() - (_height - 1 - marginY);
+    }
+
+    _origin = Position(x, y);
+    clampOrigin();
+    return Position(_origin.getX() - previous.getX(), _origin.getY() - previous.getY());
+}
+
+bool Viewport::contains(const Position& position) const {
+    return position.getX() >= _origin.getX() && position.getX() < _origin.getX() + _width &&
+           position.getY() >= _origin.getY() && position.getY() < _origin.getY() + _height;
+}
+
+Position Viewport::toLocal(const Position& position) const {
+    return Position(position.getX() - _origin.getX(), position.getY() - _origin.getY());
+}
+
+bool Viewport::coversBoard() const {
+    return _width == _boardWidth && _height == _boardHeight;
+}
+
+void Viewport::clampOrigin() {
+    int x = std::max(0, std::min(_origin.getX(), _boardWidth - _width));
+    int y = std::max(0, std::min(_origin.getY(), _boardHeight - _height));
+    _origin = Position(x, y);
+}
@@ -0,0 +1,486 @@
+#include "view/VirtualTerminal.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+const unsigned char TerminalCell::BOLD;
+const unsigned char TerminalCell::DIM;
+const unsigned char TerminalCell::ITALIC;
+const unsigned char TerminalCell::UNDERLINE;
+const unsigned char TerminalCell::INVERSE;
+const int VirtualTerminal::MAX_PARAMS;
+
+VirtualTerminal::VirtualTerminal(int columns, int rows):
+    _columns(columns), _rows(rows), _active(0), _cursorX(0), _cursorY(0), _savedX(0), _savedY(0),
+    _wrapPending(false), _autowrap(true), _cursorVisible(true), _scrollTop(0), _scrollBottom(rows - 1),
+    _state(GROUND), _paramCount(0), _private(false), _codepoint(0), _utf8Remaining(0), _frames(0) {
+    if (columns <= 0 || rows <= 0) {
+        throw std::invalid_argument("Terminal size must be positive | VirtualTerminal::VirtualTerminal()");
+    }
+
+    _screens[0].assign(static_cast<size_t>(columns) * rows, TerminalCell());
+    _screens[1].assign(static_cast<size_t>(columns) * rows, TerminalCell());
+}
+
+const TerminalCell& VirtualTerminal::at(int x, int y) const {
+    if (x < 0 || x >= _columns || y < 0 || y >= _rows) {
+        throw std::out_of_range("Cell out of screen | VirtualTerminal::at()");
+    }
+    return screen()[y * _columns + x];
+}
+
+std::string VirtualTerminal::rowText(int y) const {
+    std::string text;
+    for (int x = 0; x < _columns; x++) {
+        char32_t glyph = at(x, y).glyph;
+        if (glyph < 0x80) {
+            text += static_cast<char>(glyph);
+        } else if (glyph < 0x800) {
+            text += static_cast<char>(0xc0 | (glyph >> 6));
+            text += static_cast<char>(0x80 | (glyph & 0x3f));
+        } else if (glyph < 0x10000) {
+            text += static_cast<char>(0xe0 | (glyph >> 12));
+            text += static_cast<char>(0x80 | ((glyph >> 6) & 0x3f));
+            text += static_cast<char>(0x80 | (glyph & 0x3f));
+        } else {
+            text += static_cast<char>(0xf0 | (glyph >> 18));
+            text += static_cast<char>(0x80 | ((glyph >> 12) & 0x3f));
+            text += static_cast<char>(0x80 | ((glyph >> 6) & 0x3f));
+            text += static_cast<char>(0x80 | (glyph & 0x3f));
+        }
+    }
+    return text;
+}
+
+bool VirtualTerminal::sameScreen(const VirtualTerminal& other) const {
+    return _columns == other._columns && _rows == other._rows && screen() == other.screen();
+}
+
+int VirtualTerminal::countDifferences(const VirtualTerminal& other) const {
+    if (_columns != other._columns || _rows != other._rows) {
+        throw std::invalid_argument("Terminal sizes differ | VirtualTerminal::countDifferences()");
+    }
+
+    int differences = 0;
+    for (size_t i = 0; i < screen().size(); i++) {
+        if (screen()[i] != other.screen()[i]) {
+            differences++;
+        }
+    }
+    return differences;
+}
+
+void VirtualTerminal::resetStats() {
+    _totals = TerminalStats();
+    _frame = TerminalStats();
+    _lastFrame = TerminalStats();
+    _frames = 0;
+}
+
+int VirtualTerminal::sync() {
+    CountingSink::sync();
+    if (_frame.bytes > 0) {
+        _lastFrame = _frame;
+        _frame = TerminalStats();
+        _frames++;
+    }
+    return 0;
+}
+
+void VirtualTerminal::count(unsigned long long TerminalStats::*field, unsigned long long amount) {
+    _frame.*field += amount;
+    _totals.*field += amount;
+}
+
+void VirtualTerminal::consume(const char* data, size_t length) {
+    count(&TerminalStats::bytes, length);
+    count(&TerminalStats::writes);
+
+    for (size_t i = 0; i < length; i++) {
+        process(static_cast<unsigned char>(data[i]));
+    }
+}
+
+void VirtualTerminal::process(unsigned char byte) {
+    switch (_state) {
+        case GROUND:
+            break;
+
+        case ESC:
+            _state = GROUND;
+            if (byte == '[') {
+                _state = CSI;
+                _paramCount = 0;
+                _params[0] = 0;
+                _private = false;
+            } else if (byte == ']' || byte == 'P') {
+                _state = STRING;
+            } else if (byte == '7') {
+                _savedX = _cursorX;
+                _savedY = _cursorY;
+            } else if (byte == '8') {
+                moveCursor(_savedX, _savedY);
+            } else if (byte == 'M') {
+                if (_cursorY == _scrollTop) {
+                    scroll(-1);
+                } else {
+                    moveCursor(_cursorX, _cursorY - 1);
+                }
+            }
+            return;
+
+        case CSI:
+            if (byte >= '0' && byte <= '9') {
+                if (_paramCount == 0) {
+                    _paramCount = 1;
+                }
+                int& value = _params[_paramCount - 1];
+                value = std::min(value * 10 + (byte - '0'), 1 << 20);
+            } else if (byte == ';') {
+                if (_paramCount == 0) {
+                    _paramCount = 1;
+                }
+                if (_paramCount < MAX_PARAMS) {
+                    _params[_paramCount++] = 0;
+                }
+            } else if (byte == '?') {
+                _private = true;
+            } else if (byte >= 0x40 && byte <= 0x7e) {
+                _state = GROUND;
+                executeCsi(byte);
+            } else if (byte < 0x20 || byte > 0x7e) {
+                _state = GROUND;
+            }
+            return;
+
+        case STRING:
+            if (byte == 0x07 || byte == '\\') {
+                _state = GROUND;
+            }
+            return;
+    }
+
+    if (_utf8Remaining > 0) {
+        if ((byte & 0xc0) == 0x80) {
+            _codepoint = (_codepoint << 6) | (byte & 0x3f);
+            if (--_utf8Remaining == 0) {
+                put(_codepoint);
+            }
+            return;
+        }
+        // Оборванная последовательность: символ заменяется, байт разбирается заново
+        _utf8Remaining = 0;
+        put(U'�');
+    }
+
+    if (byte == 0x1b) {
+        _state = ESC;
+    } else if (byte < 0x20 || byte == 0x7f) {
+        control(byte);
+    } else if (byte < 0x80) {
+        put(byte);
+    } else if ((byte & 0xe0) == 0xc0) {
+        _codepoint = byte & 0x1f;
+        _utf8Remaining = 1;
+    } else if ((byte & 0xf0) == 0xe0) {
+        _codepoint = byte & 0x0f;
+        _utf8Remaining = 2;
+    } else if ((byte & 0xf8) == 0xf0) {
+        _codepoint = byte & 0x07;
+        _utf8Remaining = 3;
+    } else {
+        put(U'�');
+    }
+}
+
+void VirtualTerminal::put(char32_t glyph) {
+    if (_wrapPending) {
+        _wrapPending = false;
+        _cursorX = 0;
+        lineFeed();
+    }
+
+    TerminalCell cell = _pen;
+    cell.glyph = glyph;
+    screen()[_cursorY * _columns + _cursorX] = cell;
+    count(&TerminalStats::glyphs);
+
+    if (_cursorX + 1 < _columns) {
+        _cursorX++;
+    } else if (_autowrap) {
+        _wrapPending = true;
+    }
+}
+
+void VirtualTerminal::control(unsigned char byte) {
+    switch (byte) {
+        case '\r':
+            _cursorX = 0;
+            _wrapPending = false;
+            break;
+        case '\n':
+            _cursorX = 0;
+            _wrapPending = false;
+            lineFeed();
+            break;
+        case '\b':
+            moveCursor(_cursorX - 1, _cursorY);
+            break;
+        case '\t':
+            moveCursor((_cursorX / 8 + 1) * 8, _cursorY);
+            break;
+        default:
+            break;
+    }
+}
+
+void VirtualTerminal::lineFeed() {
+    if (_cursorY == _scrollBottom) {
+        scroll(1);
+    } else if (_cursorY + 1 < _rows) {
+        _cursorY++;
+    }
+}
+
+void VirtualTerminal::scroll(int lines) {
+    int height = _scrollBottom - _scrollTop + 1;
+    int shift = std::min(std::abs(lines), height);
+    std::vector<TerminalCell>& cells = screen();
+    auto rowBegin = [&](int y) { return cells.begin() + static_cast<std::ptrdiff_t>(y) * _columns; };
+
+    if (lines > 0) {
+        std::copy(rowBegin(_scrollTop + shift), rowBegin(_scrollBottom + 1), rowBegin(_scrollTop));
+        for (int y = _scrollBottom - shift + 1; y <= _scrollBottom; y++) {
+            erase(y, 0, _columns);
+        }
+    } else if (lines < 0) {
+        std::copy_backward(rowBegin(_scrollTop), rowBegin(_scrollBottom + 1 - shift), rowBegin(_scrollBottom + 1));
+        for (int y = _scrollTop; y < _scrollTop + shift; y++) {
+            erase(y, 0, _columns);
+        }
+    }
+}
+
+void VirtualTerminal::erase(int y, int from, int to) {
+    std::vector<TerminalCell>& cells = screen();
+    TerminalCell empty = blank();
+    for (int x = std::max(0, from); x < std::min(to, _columns); x++) {
+        cells[y * _columns + x] = empty;
+    }
+}
+
+void VirtualTerminal::moveCursor(int x, int y) {
+    _cursorX = std::max(0, std::min(x, _columns - 1));
+    _cursorY = std::max(0, std::min(y, _rows - 1));
+    _wrapPending = false;
+}
+
+int VirtualTerminal::param(int index, int fallback) const {
+    if (index >= _paramCount || _params[index] == 0) {
+        return fallback;
+    }
+    return _params[index];
+}
+
+TerminalCell VirtualTerminal::blank() const {
+    TerminalCell cell;
+    cell.bg = _pen.bg;
+    return cell;
+}
+
+void VirtualTerminal::executeCsi(unsigned char final) {
+    if (_private) {
+        if (final == 'h' || final == 'l') {
+            for (int i = 0; i < std::max(1, _paramCount); i++) {
+                setPrivateMode(_params[i], final == 'h');
+            }
+        }
+        return;
+    }
+
+    switch (final) {
+        case 'H':
+        case 'f':
+            count(&TerminalStats::cursorMoves);
+            moveCursor(param(1, 1) - 1, param(0, 1) - 1);
+            break;
+        case 'A':
+            count(&TerminalStats::cursorMoves);
+            moveCursor(_cursorX, _cursorY - param(0, 1));
+            break;
+        case 'B':
+            count(&TerminalStats::cursorMoves);
+            moveCursor(_cursorX, _cursorY + param(0, 1));
+            break;
+        case 'C':
+            count(&TerminalStats::cursorMoves);
+            moveCursor(_cursorX + param(0, 1), _cursorY);
+            break;
+        case 'D':
+            count(&TerminalStats::cursorMoves);
+            moveCursor(_cursorX - param(0, 1), _cursorY);
+            break;
+        case 'G':
+            count(&TerminalStats::cursorMoves);
+            moveCursor(param(0, 1) - 1, _cursorY);
+            break;
+        case 'd':
+            count(&TerminalStats::cursorMoves);
+            moveCursor(_cursorX, param(0, 1) - 1);
+            break;
+        case 'J': {
+            count(&TerminalStats::clears);
+            int mode = _paramCount > 0 ? _params[0] : 0;
+            if (mode == 0) {
+                erase(_cursorY, _cursorX, _columns);
+                for (int y = _cursorY + 1; y < _rows; y++) {
+                    erase(y, 0, _columns);
+                }
+            } else if (mode == 1) {
+                for (int y = 0; y < _cursorY; y++) {
+                    erase(y, 0, _columns);
+                }
+                erase(_cursorY, 0, _cursorX + 1);
+            } else if (mode == 2) {
+                for (int y = 0; y < _rows; y++) {
+                    erase(y, 0, _columns);
+                }
+            }
+            break;
+        }
+        case 'K': {
+            count(&TerminalStats::clears);
+            int mode = _paramCount > 0 ? _params[0] : 0;
+            if (mode == 0) {
+                erase(_cursorY, _cursorX, _columns);
+            } else if (mode == 1) {
+                erase(_cursorY, 0, _cursorX + 1);
+            } else if (mode == 2) {
+                erase(_cursorY, 0, _columns);
+            }
+            break;
+        }
+        case 'm':
+            count(&TerminalStats::sgrChanges);
+            applySgr();
+            break;
+        case 'r': {
+            int top = param(0, 1) - 1;
+            int bottom = param(1, _rows) - 1;
+            if (top < bottom && bottom < _rows) {
+                _scrollTop = top;
+                _scrollBottom = bottom;
+            } else {
+                _scrollTop = 0;
+                _scrollBottom = _rows - 1;
+            }
+            moveCursor(0, 0);
+            break;
+        }
+        case 'S':
+            count(&TerminalStats::scrolls);
+            scroll(param(0, 1));
+            break;
+        case 'T':
+            count(&TerminalStats::scrolls);
+            scroll(-param(0, 1));
+            break;
+        case 's':
+            _savedX = _cursorX;
+            _savedY = _cursorY;
+            break;
+        case 'u':
+            moveCursor(_savedX, _savedY);
+            break;
+        default:
+            break;
+    }
+}
+
+void VirtualTerminal::setPrivateMode(int mode, bool enable) {
+    switch (mode) {
+        case 7:
+            _autowrap = enable;
+            if (!enable) {
+                _wrapPending = false;
+            }
+            break;
+        case 25:
+            _cursorVisible = enable;
+            break;
+        case 1049: {
+            int target = enable ? 1 : 0;
+            if (target == _active) {
+                break;
+            }
+            if (enable) {
+                _savedX = _cursorX;
+                _savedY = _cursorY;
+                _active = 1;
+                _screens[1].assign(_screens[1].size(), TerminalCell());
+            } else {
+                _active = 0;
+                moveCursor(_savedX, _savedY);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void VirtualTerminal::applySgr() {
+    if (_paramCount == 0) {
+        _pen = TerminalCell();
+        return;
+    }
+
+    for (int i = 0; i < _paramCount; i++) {
+        int code = _params[i];
+        if (code == 0) {
+            _pen = TerminalCell();
+        } else if (code == 1) {
+            _pen.attrs |= TerminalCell::BOLD;
+        } else if (code == 2) {
+            _pen.attrs |= TerminalCell::DIM;
+        } else if (code == 3) {
+            _pen.attrs |= TerminalCell::ITALIC;
+        } else if (code == 4) {
+            _pen.attrs |= TerminalCell::UNDERLINE;
+        } else if (code == 7) {
+            _pen.attrs |= TerminalCell::INVERSE;
+        } else if (code == 22) {
+            _pen.attrs &= ~(TerminalCell::BOLD | TerminalCell::DIM);
+        } else if (code == 23) {
+            _pen.attrs &= ~TerminalCell::ITALIC;
+        } else if (code == 24) {
+            _pen.attrs &= ~TerminalCell::UNDERLINE;
+        } else if (code == 27) {
+            _pen.attrs &= ~TerminalCell::INVERSE;
+        } else if (code >= 30 && code <= 37) {
+            _pen.fg = code - 30;
+        } else if (code == 39) {
+            _pen.fg = -1;
+        } else if (code >= 40 && code <= 47) {
+            _pen.bg = code - 40;
+        } else if (code == 49) {
+            _pen.bg = -1;
+        } else if (code >= 90 && code <= 97) {
+            _pen.fg = code - 90 + 8;
+        } else if (code >= 100 && code <= 107) {
+            _pen.bg = code - 100 + 8;
+        } else if ((code == 38 || code == 48) && i + 1 < _paramCount) {
+            int color = -1;
+            if (_params[i + 1] == 5 && i + 2 < _paramCount) {
+                color = _params[i + 2] & 0xff;
+                i += 2;
+            } else if (_params[i + 1] == 2 && i + 4 < _paramCount) {
+                color = 0x1000000 | ((_params[i + 2] & 0xff) << 16) | ((_params[i + 3] & 0xff) << 8) | (_params[i + 4] & 0xff);
+                i += 4;
+            } else {
+                i += 1;
+            }
+            (code == 38 ? _pen.fg : _pen.bg) = color;
+        }
+    }
+}